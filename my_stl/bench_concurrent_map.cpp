@@ -0,0 +1,156 @@
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <mutex>
+#include <random>
+#include <thread>
+#include "my_stl_concurrent_map.h"
+#include "my_stl_vector.h"
+
+//д95:5ʱȽһȫֻrb_treeͰΧƬmy_concurrent_mapڲͬ߳µ
+//룺g++ -std=c++17 -O2 -pthread bench_concurrent_map.cpp -o bench_concurrent_mapC++14Ͼɣ
+//÷bench_concurrent_map [ĸ] [ÿ̵߳Ĳ]
+
+typedef pair<const unsigned, unsigned> value_type;
+typedef rb_tree<unsigned, value_type, my_select1st<value_type>, less<unsigned>, malloc_alloc> tree_type;
+
+struct locked_tree
+{
+    mutex lock;
+    tree_type tree;
+
+    bool find(unsigned k, unsigned& out)
+    {
+        lock_guard<mutex> guard(lock);
+        tree_type::iterator it = tree.find(k);
+        if (it == tree.end())
+        {
+            return false;
+        }
+        out = (*it).second;
+        return true;
+    }
+    void insert(unsigned k)
+    {
+        lock_guard<mutex> guard(lock);
+        tree.insert_unique(value_type(k, k));
+    }
+    void erase(unsigned k)
+    {
+        lock_guard<mutex> guard(lock);
+        tree.erase(k);
+    }
+};
+
+struct sharded_map
+{
+    my_concurrent_map<unsigned, unsigned> map;
+
+    template <class InputIterator>
+    sharded_map(InputIterator first, InputIterator last) : map(first, last) {}
+
+    bool find(unsigned k, unsigned& out)
+    {
+        return map.find(k, out);
+    }
+    void insert(unsigned k)
+    {
+        map.insert(value_type(k, k));
+    }
+    void erase(unsigned k)
+    {
+        map.erase(k);
+    }
+};
+
+//ÿ߳opsβ5%ǲɾÿܲ
+template <class Map>
+double run(Map& m, unsigned keys, unsigned threads, unsigned ops)
+{
+    atomic<unsigned> ready(0);
+    atomic<bool> go(false);
+    atomic<unsigned long long> hits(0);
+    my_vector<thread*> workers;
+    for (unsigned t = 0; t < threads; ++t)
+    {
+        workers.push_back(new thread([&, t]()
+        {
+            mt19937 rng(t + 1);
+            unsigned long long local_hits = 0;
+            unsigned out = 0;
+            ++ready;
+            while (!go.load())
+            {
+                this_thread::yield();
+            }
+            for (unsigned i = 0; i < ops; ++i)
+            {
+                unsigned k = rng() % keys;
+                unsigned r = rng() % 100;
+                if (r < 95)
+                {
+                    local_hits += m.find(k, out);
+                }
+                else if (r < 98)
+                {
+                    m.insert(k);
+                }
+                else
+                {
+                    m.erase(k);
+                }
+            }
+            hits += local_hits;
+        }));
+    }
+    while (ready.load() != threads)
+    {
+        this_thread::yield();
+    }
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    go = true;
+    for (unsigned t = 0; t < threads; ++t)
+    {
+        workers[t]->join();
+        delete workers[t];
+    }
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    return double(ops) * threads / seconds;
+}
+
+int main(int argc, char** argv)
+{
+    unsigned keys = argc > 1 ? (unsigned)atoi(argv[1]) : 1000000;
+    unsigned ops = argc > 2 ? (unsigned)atoi(argv[2]) : 1000000;
+    unsigned cores = thread::hardware_concurrency();
+    if (cores == 0)
+    {
+        cores = 4;
+    }
+
+    //Ƭȡ4ķΧȻ
+    unsigned nshards = cores * 4;
+    my_vector<unsigned> bounds;
+    for (unsigned i = 1; i < nshards; ++i)
+    {
+        bounds.push_back((unsigned)((unsigned long long)keys * i / nshards));
+    }
+
+    locked_tree global;
+    sharded_map sharded(bounds.begin(), bounds.end());
+    for (unsigned k = 0; k < keys; k += 2)
+    {
+        global.insert(k);
+        sharded.insert(k);
+    }
+
+    printf("keys=%u ops/thread=%u shards=%u\n", keys, ops, nshards);
+    printf("%8s %16s %16s\n", "threads", "global mutex", "sharded");
+    for (unsigned threads = 1; threads <= cores; threads *= 2)
+    {
+        double a = run(global, keys, threads, ops);
+        double b = run(sharded, keys, threads, ops);
+        printf("%8u %14.2fM/s %14.2fM/s\n", threads, a / 1e6, b / 1e6);
+    }
+    return 0;
+}
@@ -22,7 +22,7 @@ int main()
     for (; it != itree.end(); ++it)
     {
         rbit = __rb_tree_base_iterator(it);
-        cout << *it << "(" << rbit.node->color << ")" << " ";
+        cout << *it << "(" << rbit.node->get_color() << ")" << " ";
     }
     cout << endl;
     int aa;
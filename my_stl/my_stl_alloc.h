@@ -1,7 +1,10 @@
 #ifndef __MY_STL_ALLOC_H
 #define __MY_STL_ALLOC_H
 
+#include <atomic>
 #include <iostream>
+#include <new>
+#include <utility>
 #define __THROW_BAD_ALLOC std::cerr << "out of memory" << std::endl; exit(1)
 
 template<class T, class Alloc>
@@ -26,6 +29,11 @@ public:
     {
         Alloc::deallocate(p, sizeof(T));
     }
+    //һcountÿԵdeallocate(p)黹
+    static void allocate_batch(T **out, size_t count)
+    {
+        Alloc::allocate_batch(sizeof(T), (void **)out, count);
+    }
 };
 
 //һ
@@ -52,6 +60,14 @@ public:
         free(p);
     }
 
+    static void allocate_batch(size_t n, void **out, size_t count)
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            out[i] = allocate(n);
+        }
+    }
+
     static void *reallocate(void *p, size_t, size_t new_sz)
     {
         void *result = realloc(p, new_sz);
@@ -188,6 +204,7 @@ public:
         *my_free_list = q;
     }
     static void *reallocate(void *p, size_t old_sz, size_t new_sz);
+    static void allocate_batch(size_t n, void **out, size_t count);
 };
 
 template <bool threads, int inst>
@@ -237,6 +254,41 @@ void* __default_alloc_template<threads, inst>::refill(size_t n)
     return (result);
 }
 
+//ãȡfree listֳɵģĲֱӴڴسɶгfree list
+//гĶ˴ڣʺһνĳ
+template <bool threads, int inst>
+void __default_alloc_template<threads, inst>::allocate_batch(size_t n, void **out, size_t count)
+{
+    size_t i = 0;
+    if (n > (size_t)__MAX_BYTES)
+    {
+        for (; i < count; ++i)
+        {
+            out[i] = malloc_alloc::allocate(n);
+        }
+        return;
+    }
+
+    obj * volatile * my_free_list = free_list + FREELIST_INDEX(n);
+    while (i < count && *my_free_list != 0)
+    {
+        obj * result = *my_free_list;
+        *my_free_list = result->free_list_link;
+        out[i++] = result;
+    }
+
+    n = ROUND_UP(n);
+    while (i < count)
+    {
+        int nobjs = count - i > 512 ? 512 : (int)(count - i);
+        char * chunk = chunk_alloc(n, nobjs);   //ڲ֤ٷ1
+        for (int j = 0; j < nobjs; ++j)
+        {
+            out[i++] = chunk + j * n;
+        }
+    }
+}
+
 template <bool threads, int inst>
 char* __default_alloc_template<threads, inst>::chunk_alloc(size_t size, int & nobjs)
 {
@@ -310,4 +362,250 @@ char* __default_alloc_template<threads, inst>::chunk_alloc(size_t size, int & no
 
 typedef __default_alloc_template<0, 0> my_alloc;
 
+//أΪһ̶ֹСĶά˽еfree listռÿAllocɿҪĶصfree list
+//ڶǲ__MAX_BYTESƣҲʱһι黹ȫڴ
+//share֮عͬԭڴ飬ԵĶȻֱ黹Եfree listһͷʱŹ黹Щڴ
+template <class T, class Alloc = my_alloc>
+class __object_pool
+{
+private:
+    union obj
+    {
+        union obj * free_list_link;
+        char client_data[1];
+    };
+    struct chunk
+    {
+        chunk * next;
+        size_t bytes;
+    };
+    //عͬеһڴ飬߿ڲͬ߳ͷţԭӲ
+    struct shared_chunks
+    {
+        chunk * chunks;
+        std::atomic<size_t> refs;
+    };
+    //سеһshared_chunks
+    struct share_link
+    {
+        shared_chunks * group;
+        share_link * next;
+    };
+
+    enum { object_align = alignof(T) > alignof(obj) ? alignof(T) : alignof(obj) };
+    enum { object_size = ((sizeof(T) > sizeof(obj) ? sizeof(T) : sizeof(obj)) + object_align - 1) & ~(object_align - 1) };
+    enum { chunk_header = (sizeof(chunk) + object_align - 1) & ~(object_align - 1) };
+    enum { max_chunk_objects = 1024 };
+
+    obj * free_list;
+    chunk * chunks;     //Ѿڴ飬ʱ黹
+    share_link * shares;    //عͬеڴ
+    char * start_free;  //ǰڴδгĲ
+    char * end_free;
+    size_t next_chunk_objects;  //һгĶÿηֱmax_chunk_objects
+
+    void chunk_alloc()
+    {
+        size_t bytes = chunk_header + next_chunk_objects * object_size;
+        chunk * c = (chunk *)Alloc::allocate(bytes);
+        c->next = chunks;
+        c->bytes = bytes;
+        chunks = c;
+        start_free = (char *)c + chunk_header;
+        end_free = (char *)c + bytes;
+        if (next_chunk_objects < (size_t)max_chunk_objects)
+        {
+            next_chunk_objects *= 2;
+        }
+    }
+
+    static void free_chunks(chunk * c)
+    {
+        while (c != 0)
+        {
+            chunk * next = c->next;
+            Alloc::deallocate(c, c->bytes);
+            c = next;
+        }
+    }
+    share_link ** find_share(shared_chunks * g)
+    {
+        share_link ** p = &shares;
+        while (*p != 0 && (*p)->group != g)
+        {
+            p = &(*p)->next;
+        }
+        return p;
+    }
+    //Ѿgʱظ
+    void attach(shared_chunks * g)
+    {
+        if (*find_share(g) != 0)
+        {
+            return;
+        }
+        g->refs.fetch_add(1, std::memory_order_relaxed);
+        share_link * s = (share_link *)Alloc::allocate(sizeof(share_link));
+        s->group = g;
+        s->next = shares;
+        shares = s;
+    }
+    //ѱĳصһݳs*thisѾͬһʱݺΪһݣ
+    //ϲֻʣ*thisе𿪣ڴ*thisԼѡʱĿ
+    void merge_share(share_link * s)
+    {
+        share_link ** p = find_share(s->group);
+        if (*p == 0)
+        {
+            s->next = shares;
+            shares = s;
+            return;
+        }
+        shared_chunks * g = s->group;
+        Alloc::deallocate(s, sizeof(share_link));
+        if (g->refs.fetch_sub(1, std::memory_order_acq_rel) != 2)
+        {
+            return;
+        }
+        share_link * own = *p;
+        *p = own->next;
+        Alloc::deallocate(own, sizeof(share_link));
+        chunk * last = g->chunks;
+        while (last->next != 0)
+        {
+            last = last->next;
+        }
+        last->next = chunks;
+        chunks = g->chunks;
+        g->~shared_chunks();
+        Alloc::deallocate(g, sizeof(shared_chunks));
+    }
+
+public:
+    __object_pool() : free_list(0), chunks(0), shares(0), start_free(0), end_free(0), next_chunk_objects(8) {}
+    ~__object_pool()
+    {
+        release();
+    }
+
+    __object_pool(const __object_pool&) = delete;
+    __object_pool& operator=(const __object_pool&) = delete;
+
+    T *allocate()
+    {
+        if (free_list != 0)
+        {
+            obj * result = free_list;
+            free_list = result->free_list_link;
+            return (T *)result;
+        }
+        if (start_free == end_free)
+        {
+            chunk_alloc();
+        }
+        T * result = (T *)start_free;
+        start_free += object_size;
+        return result;
+    }
+    void deallocate(T *p)
+    {
+        obj * q = (obj *)p;
+        q->free_list_link = free_list;
+        free_list = q;
+    }
+
+    //黹ȫڴ飬֮ǰóȥĶȫʧЧͬеڴֻԼһ
+    void release()
+    {
+        free_chunks(chunks);
+        chunks = 0;
+        while (shares != 0)
+        {
+            share_link * next = shares->next;
+            if (shares->group->refs.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            {
+                free_chunks(shares->group->chunks);
+                shares->group->~shared_chunks();
+                Alloc::deallocate(shares->group, sizeof(shared_chunks));
+            }
+            Alloc::deallocate(shares, sizeof(share_link));
+            shares = next;
+        }
+        free_list = 0;
+        start_free = 0;
+        end_free = 0;
+        next_chunk_objects = 8;
+    }
+
+    //ӹxȫڴ飬xóȥĶ˺*this黹ͷţxΪճ
+    void splice(__object_pool& x)
+    {
+        while (x.shares != 0)
+        {
+            share_link * s = x.shares;
+            x.shares = s->next;
+            merge_share(s);
+        }
+        //xĿйͬеڴеĶ󣬼ʹxԼûڴҲҪӹ
+        while (x.free_list != 0)
+        {
+            obj * q = x.free_list;
+            x.free_list = q->free_list_link;
+            q->free_list_link = free_list;
+            free_list = q;
+        }
+        if (x.chunks == 0)
+        {
+            return;
+        }
+        chunk * last = x.chunks;
+        while (last->next != 0)
+        {
+            last = last->next;
+        }
+        last->next = chunks;
+        chunks = x.chunks;
+        //xǰڴûгĲֲʹãڴһͷ
+        x.chunks = 0;
+        x.start_free = 0;
+        x.end_free = 0;
+        x.next_chunk_objects = 8;
+    }
+
+    //˺*thisóȥĶԽxʹú͹黹x*thisͬ*thisڵȫڴ飬O(߹ͬе֮)
+    void share(__object_pool& x)
+    {
+        for (share_link * s = shares; s != 0; s = s->next)
+        {
+            x.attach(s->group);
+        }
+        if (chunks != 0)
+        {
+            shared_chunks * g = (shared_chunks *)Alloc::allocate(sizeof(shared_chunks));
+            g->chunks = chunks;
+            new (&g->refs) std::atomic<size_t>(0);
+            chunks = 0;
+            attach(g);
+            x.attach(g);
+        }
+    }
+
+    void swap(__object_pool& x)
+    {
+        std::swap(free_list, x.free_list);
+        std::swap(chunks, x.chunks);
+        std::swap(shares, x.shares);
+        std::swap(start_free, x.start_free);
+        std::swap(end_free, x.end_free);
+        std::swap(next_chunk_objects, x.next_chunk_objects);
+    }
+};
+
+//ǣ̬ӿAllocȫͬĿǰrb_treeʱΪÿԴһ__object_pool
+//ڵãصڴAlloc
+template <class Alloc = my_alloc>
+struct my_pool_alloc : public Alloc
+{
+};
+
 #endif //__MY_STL_ALLOC_H
\ No newline at end of file
@@ -0,0 +1,1015 @@
+#ifndef __MY_STL_BTREE_H
+#define __MY_STL_BTREE_H
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include "my_stl_alloc.h"
+#include "my_stl_construct.h"
+#include "my_stl_tree.h"
+using namespace std;
+
+//B+ֵҶڵУҶڵ㴮˫ڲڵֻŷָӽڵָ
+//һڵԼNodeBytesֽڣĬ4cache lineڵڵļţһڵֻҪ޷֧Ƚ
+//ɾڽڵԪأκ޸֮ԪصַʧЧҪڵȶʱӦʹrb_tree
+//ֵֻּ֧ΨһĲ
+
+//ڵܷŵĲΪ4Ѻϲÿڵ㶼Ϊ
+constexpr size_t __btree_slots(size_t node_bytes, size_t header, size_t slot_bytes)
+{
+    return node_bytes > header + 4 * slot_bytes ? (node_bytes - header) / slot_bytes : 4;
+}
+
+struct __btree_node_base
+{
+    __btree_node_base* parent;  //ڵ㣬ڵΪ0
+    unsigned short count;       //ҶڵΪֵĸڲڵΪĸ
+    unsigned short position;    //ڸڵchildrenе±
+    bool leaf;
+};
+
+template <class Value, size_t Slots>
+struct __btree_leaf_node : public __btree_node_base
+{
+    __btree_leaf_node* prev;
+    __btree_leaf_node* next;
+    typename aligned_storage<sizeof(Value), alignof(Value)>::type slots[Slots];
+
+    Value* values()
+    {
+        return (Value*)slots;
+    }
+};
+
+//ڲڵcountcount + 1ӽڵ㣬children[i]еļСkeys[i]children[i + 1]еļСkeys[i]
+template <class Key, size_t Slots>
+struct __btree_internal_node : public __btree_node_base
+{
+    typename aligned_storage<sizeof(Key), alignof(Key)>::type slots[Slots];
+    __btree_node_base* children[Slots + 1];
+
+    Key* keys()
+    {
+        return (Key*)slots;
+    }
+};
+
+//[src, src + n)ᵽdstοصֽڿܵõȼ۶ֱmemmove
+template <class T>
+inline void __btree_relocate(T* dst, T* src, size_t n)
+{
+    if (is_trivially_copy_constructible<T>::value && is_trivially_destructible<T>::value)
+    {
+        memmove((void*)dst, (const void*)src, n * sizeof(T));
+    }
+    else if (dst < src)
+    {
+        for (size_t i = 0; i < n; ++i)
+        {
+            construct(dst + i, std::move(src[i]));
+            ::destroy(src + i);
+        }
+    }
+    else if (dst > src)
+    {
+        for (size_t i = n; i > 0; --i)
+        {
+            construct(dst + i - 1, std::move(src[i - 1]));
+            ::destroy(src + i - 1);
+        }
+    }
+}
+
+template <class Leaf>
+struct __btree_base_iterator
+{
+    typedef bidirectional_iterator_tag iterator_category;
+    typedef ptrdiff_t difference_type;
+
+    Leaf* node;
+    size_t position;
+
+    //ߵҶڵĩβʱһҶڵĿͷһҶڵĩβend()
+    void increment()
+    {
+        ++position;
+        if (position == node->count && node->next != 0)
+        {
+            node = node->next;
+            position = 0;
+        }
+    }
+
+    void decrement()
+    {
+        if (position == 0)
+        {
+            node = node->prev;
+            position = node->count;
+        }
+        --position;
+    }
+};
+
+template <class Leaf>
+inline bool operator==(const __btree_base_iterator<Leaf>& x, const __btree_base_iterator<Leaf>& y)
+{
+    return x.node == y.node && x.position == y.position;
+}
+
+template <class Leaf>
+inline bool operator!=(const __btree_base_iterator<Leaf>& x, const __btree_base_iterator<Leaf>& y)
+{
+    return !(x == y);
+}
+
+template <class Value, class Ref, class Ptr, class Leaf>
+struct __btree_iterator : public __btree_base_iterator<Leaf>
+{
+    typedef Value value_type;
+    typedef Ref reference;
+    typedef Ptr pointer;
+    typedef __btree_iterator<Value, Value&, Value*, Leaf> iterator;
+    typedef __btree_iterator<Value, const Value&, const Value*, Leaf> const_iterator;
+    typedef __btree_iterator<Value, Ref, Ptr, Leaf> self;
+
+    __btree_iterator()
+    {
+        this->node = 0;
+        this->position = 0;
+    }
+    __btree_iterator(Leaf* x, size_t pos)
+    {
+        this->node = x;
+        this->position = pos;
+    }
+    __btree_iterator(const iterator& it)
+    {
+        this->node = it.node;
+        this->position = it.position;
+    }
+    //iteratorʵĹ캯ǿ죬Ҫʽֵ
+    self& operator=(const self&) = default;
+
+    reference operator*() const
+    {
+        return this->node->values()[this->position];
+    }
+    pointer operator->() const
+    {
+        return &(operator*());
+    }
+
+    self& operator++()
+    {
+        this->increment();
+        return *this;
+    }
+    self operator++(int)
+    {
+        self tmp = *this;
+        this->increment();
+        return tmp;
+    }
+    self& operator--()
+    {
+        this->decrement();
+        return *this;
+    }
+    self operator--(int)
+    {
+        self tmp = *this;
+        this->decrement();
+        return tmp;
+    }
+};
+
+template <class Key, class Value, class KeyOfValue, class Compare, class Alloc = my_alloc, size_t NodeBytes = 256>
+class btree
+{
+public:
+    enum { leaf_slots = __btree_slots(NodeBytes, sizeof(__btree_node_base) + 2 * sizeof(void*), sizeof(Value)) };
+    enum { internal_slots = __btree_slots(NodeBytes, sizeof(__btree_node_base) + sizeof(void*), sizeof(Key) + sizeof(void*)) };
+    static_assert(leaf_slots < 65536 && internal_slots < 65536, "node is too large");
+
+protected:
+    typedef __btree_node_base* base_ptr;
+    typedef __btree_leaf_node<Value, leaf_slots> leaf_node;
+    typedef __btree_internal_node<Key, internal_slots> internal_node;
+    enum { leaf_min = leaf_slots / 2 };         //ǸڵҪеֵ
+    enum { internal_min = internal_slots / 2 }; //ǸڵҪеļ
+
+public:
+    typedef Key key_type;
+    typedef Value value_type;
+    typedef value_type* pointer;
+    typedef const value_type* const_pointer;
+    typedef value_type& reference;
+    typedef const value_type& const_reference;
+    typedef size_t size_type;
+    typedef ptrdiff_t difference_type;
+    typedef __btree_iterator<value_type, reference, pointer, leaf_node> iterator;
+    typedef __btree_iterator<value_type, const_reference, const_pointer, leaf_node> const_iterator;
+    typedef std::reverse_iterator<iterator> reverse_iterator;
+    typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+
+protected:
+    __object_pool<leaf_node, Alloc> leaf_pool;
+    __object_pool<internal_node, Alloc> internal_pool;
+    base_ptr root;          //ʱΪ0
+    leaf_node* leftmost;    //һҶڵ
+    leaf_node* rightmost;   //һҶڵ
+    size_type node_count;   //ֵĸ
+    Compare key_compare;
+
+    static const Key& key(const value_type& v)
+    {
+        return KeyOfValue()(v);
+    }
+
+    leaf_node* create_leaf()
+    {
+        leaf_node* x = leaf_pool.allocate();
+        x->parent = 0;
+        x->count = 0;
+        x->position = 0;
+        x->leaf = true;
+        x->prev = 0;
+        x->next = 0;
+        return x;
+    }
+    internal_node* create_internal()
+    {
+        internal_node* x = internal_pool.allocate();
+        x->parent = 0;
+        x->count = 0;
+        x->position = 0;
+        x->leaf = false;
+        return x;
+    }
+
+    //xǷk֮ǰupperΪfalseʱжx < kΪtrueʱжx <= k
+    bool before(const Key& x, const Key& k, bool upper) const
+    {
+        return upper ? !key_compare(k, x) : key_compare(x, k);
+    }
+
+    //޷ֲ֧ңÿֻһαȽѡһε㣬Ͷת
+    //[first, first + n)еһk֮ǰλ
+    template <class T, class KeyOf>
+    size_type search(const T* first, size_type n, const Key& k, KeyOf key_of, bool upper) const
+    {
+        if (n == 0)
+        {
+            return 0;
+        }
+        const T* base = first;
+        while (n > 1)
+        {
+            size_type half = n / 2;
+            base = before(key_of(base[half]), k, upper) ? base + half : base;
+            n -= half;
+        }
+        return (base - first) + before(key_of(*base), k, upper);
+    }
+
+    //Ӹ½kҶڵ㣬ÿڲڵѡһkķָߵӽڵ
+    leaf_node* find_leaf(const Key& k) const
+    {
+        base_ptr x = root;
+        while (!x->leaf)
+        {
+            internal_node* p = (internal_node*)x;
+            x = p->children[search(p->keys(), p->count, k, my_identity<Key>(), true)];
+        }
+        return (leaf_node*)x;
+    }
+
+    //ҶڵĩβλûһҶڵĿͷ
+    static iterator make_iterator(leaf_node* x, size_type pos)
+    {
+        if (pos == x->count && x->next != 0)
+        {
+            return iterator(x->next, 0);
+        }
+        return iterator(x, pos);
+    }
+
+    //pchildren[first..count]ĸڵ±
+    static void adopt(internal_node* p, size_type first)
+    {
+        for (size_type i = first; i <= p->count; ++i)
+        {
+            p->children[i]->parent = p;
+            p->children[i]->position = (unsigned short)i;
+        }
+    }
+
+    void link_leaf(leaf_node* x, leaf_node* r);
+    void insert_internal(internal_node* p, size_type pos, const Key& k, base_ptr child);
+    void insert_into_parent(base_ptr left, const Key& k, base_ptr right);
+    leaf_node* split_leaf(leaf_node* x);
+    void remove_from_internal(internal_node* p, size_type pos);
+    void rebalance_leaf(leaf_node* x);
+    void rebalance_internal(internal_node* p);
+    void destroy_subtree(base_ptr x);
+
+public:
+    btree(const Compare& comp = Compare())
+        : root(0), leftmost(0), rightmost(0), node_count(0), key_compare(comp) {}
+
+    btree(const btree& x) : root(0), leftmost(0), rightmost(0), node_count(0), key_compare(x.key_compare)
+    {
+        insert_unique(x.begin(), x.end());
+    }
+
+    ~btree()
+    {
+        clear();
+    }
+
+    btree& operator=(const btree& x)
+    {
+        if (this != &x)
+        {
+            clear();
+            key_compare = x.key_compare;
+            insert_unique(x.begin(), x.end());
+        }
+        return *this;
+    }
+
+    Compare key_comp() const
+    {
+        return key_compare;
+    }
+    iterator begin()
+    {
+        return iterator(leftmost, 0);
+    }
+    iterator end()
+    {
+        return iterator(rightmost, rightmost != 0 ? rightmost->count : 0);
+    }
+    const_iterator begin() const
+    {
+        return const_iterator(leftmost, 0);
+    }
+    const_iterator end() const
+    {
+        return const_iterator(rightmost, rightmost != 0 ? rightmost->count : 0);
+    }
+    reverse_iterator rbegin()
+    {
+        return reverse_iterator(end());
+    }
+    reverse_iterator rend()
+    {
+        return reverse_iterator(begin());
+    }
+    const_reverse_iterator rbegin() const
+    {
+        return const_reverse_iterator(end());
+    }
+    const_reverse_iterator rend() const
+    {
+        return const_reverse_iterator(begin());
+    }
+    bool empty() const
+    {
+        return node_count == 0;
+    }
+    size_type size() const
+    {
+        return node_count;
+    }
+
+    void swap(btree& x)
+    {
+        leaf_pool.swap(x.leaf_pool);
+        internal_pool.swap(x.internal_pool);
+        std::swap(root, x.root);
+        std::swap(leftmost, x.leftmost);
+        std::swap(rightmost, x.rightmost);
+        std::swap(node_count, x.node_count);
+        std::swap(key_compare, x.key_compare);
+    }
+
+public:
+    pair<iterator, bool> insert_unique(const value_type& v);
+    template <class InputIterator>
+    void insert_unique(InputIterator first, InputIterator last)
+    {
+        for (; first != last; ++first)
+        {
+            insert_unique(*first);
+        }
+    }
+
+    void erase(iterator position);
+    size_type erase(const Key& k)
+    {
+        iterator it = find(k);
+        if (it == end())
+        {
+            return 0;
+        }
+        erase(it);
+        return 1;
+    }
+    void erase(iterator first, iterator last);
+
+    //ȫֵѽڵڴ黹
+    void clear()
+    {
+        if (root != 0)
+        {
+            destroy_subtree(root);
+        }
+        leaf_pool.release();
+        internal_pool.release();
+        root = 0;
+        leftmost = 0;
+        rightmost = 0;
+        node_count = 0;
+    }
+
+    iterator lower_bound(const Key& k)
+    {
+        if (root == 0)
+        {
+            return end();
+        }
+        leaf_node* x = find_leaf(k);
+        return make_iterator(x, search(x->values(), x->count, k, KeyOfValue(), false));
+    }
+    const_iterator lower_bound(const Key& k) const
+    {
+        return const_cast<btree*>(this)->lower_bound(k);
+    }
+    iterator upper_bound(const Key& k)
+    {
+        if (root == 0)
+        {
+            return end();
+        }
+        leaf_node* x = find_leaf(k);
+        return make_iterator(x, search(x->values(), x->count, k, KeyOfValue(), true));
+    }
+    const_iterator upper_bound(const Key& k) const
+    {
+        return const_cast<btree*>(this)->upper_bound(k);
+    }
+    pair<iterator, iterator> equal_range(const Key& k)
+    {
+        return pair<iterator, iterator>(lower_bound(k), upper_bound(k));
+    }
+    pair<const_iterator, const_iterator> equal_range(const Key& k) const
+    {
+        return pair<const_iterator, const_iterator>(lower_bound(k), upper_bound(k));
+    }
+    iterator find(const Key& k)
+    {
+        iterator j = lower_bound(k);
+        return (j == end() || key_compare(k, key(*j))) ? end() : j;
+    }
+    const_iterator find(const Key& k) const
+    {
+        return const_cast<btree*>(this)->find(k);
+    }
+    size_type count(const Key& k) const
+    {
+        return find(k) == end() ? 0 : 1;
+    }
+};
+
+//rҶڵxĺ
+template <class Key, class Value, class KeyOfValue, class Compare, class Alloc, size_t NodeBytes>
+void btree<Key, Value, KeyOfValue, Compare, Alloc, NodeBytes>::link_leaf(leaf_node* x, leaf_node* r)
+{
+    r->prev = x;
+    r->next = x->next;
+    if (x->next != 0)
+    {
+        x->next->prev = r;
+    }
+    else
+    {
+        rightmost = r;
+    }
+    x->next = r;
+}
+
+//δڲڵpвkchildΪkұߵӽڵ
+template <class Key, class Value, class KeyOfValue, class Compare, class Alloc, size_t NodeBytes>
+void btree<Key, Value, KeyOfValue, Compare, Alloc, NodeBytes>::insert_internal(internal_node* p, size_type pos, const Key& k, base_ptr child)
+{
+    Key* keys = p->keys();
+    __btree_relocate(keys + pos + 1, keys + pos, p->count - pos);
+    memmove(p->children + pos + 2, p->children + pos + 1, (p->count - pos) * sizeof(base_ptr));
+    construct(keys + pos, k);
+    p->children[pos + 1] = child;
+    ++p->count;
+    adopt(p, pos + 1);
+}
+
+//leftѳright󣬰ѷָk븸ڵ㣻ڵʱϷ
+template <class Key, class Value, class KeyOfValue, class Compare, class Alloc, size_t NodeBytes>
+void btree<Key, Value, KeyOfValue, Compare, Alloc, NodeBytes>::insert_into_parent(base_ptr left, const Key& k, base_ptr right)
+{
+    internal_node* p = (internal_node*)left->parent;
+    if (p == 0)
+    {
+        //ѵǸڵ㣬һ
+        internal_node* new_root = create_internal();
+        construct(new_root->keys(), k);
+        new_root->count = 1;
+        new_root->children[0] = left;
+        new_root->children[1] = right;
+        adopt(new_root, 0);
+        root = new_root;
+        return;
+    }
+
+    size_type pos = left->position;
+    if (p->count < size_type(internal_slots))
+    {
+        insert_internal(p, pos, k, right);
+        return;
+    }
+
+    //pinternal_slots + 1мһƣƽָp½ڵq
+    const size_type n = internal_slots;
+    const size_type mid = (n + 1) / 2;
+    internal_node* q = create_internal();
+    Key* pk = p->keys();
+    Key* qk = q->keys();
+    if (pos < mid)
+    {
+        //¼ߣԭĵmid - 1
+        Key up(std::move(pk[mid - 1]));
+        ::destroy(pk + mid - 1);
+        __btree_relocate(qk, pk + mid, n - mid);
+        memcpy(q->children, p->children + mid, (n - mid + 1) * sizeof(base_ptr));
+        q->count = (unsigned short)(n - mid);
+        p->count = (unsigned short)(mid - 1);
+        adopt(q, 0);
+        insert_internal(p, pos, k, right);
+        insert_into_parent(p, up, q);
+    }
+    else if (pos == mid)
+    {
+        //¼м䣬ԼƣrightΪqĵһӽڵ
+        __btree_relocate(qk, pk + mid, n - mid);
+        q->children[0] = right;
+        memcpy(q->children + 1, p->children + mid + 1, (n - mid) * sizeof(base_ptr));
+        q->count = (unsigned short)(n - mid);
+        p->count = (unsigned short)mid;
+        adopt(q, 0);
+        insert_into_parent(p, k, q);
+    }
+    else
+    {
+        //¼Ұߣԭĵmid
+        Key up(std::move(pk[mid]));
+        ::destroy(pk + mid);
+        __btree_relocate(qk, pk + mid + 1, n - mid - 1);
+        memcpy(q->children, p->children + mid + 1, (n - mid) * sizeof(base_ptr));
+        q->count = (unsigned short)(n - mid - 1);
+        p->count = (unsigned short)mid;
+        adopt(q, 0);
+        insert_internal(q, pos - mid - 1, k, right);
+        insert_into_parent(p, up, q);
+    }
+}
+
+//Ҷڵxĺһᵽ½ڵУ½ڵ
+template <class Key, class Value, class KeyOfValue, class Compare, class Alloc, size_t NodeBytes>
+typename btree<Key, Value, KeyOfValue, Compare, Alloc, NodeBytes>::leaf_node*
+btree<Key, Value, KeyOfValue, Compare, Alloc, NodeBytes>::split_leaf(leaf_node* x)
+{
+    leaf_node* r = create_leaf();
+    size_type keep = x->count - x->count / 2;
+    __btree_relocate(r->values(), x->values() + keep, x->count - keep);
+    r->count = (unsigned short)(x->count - keep);
+    x->count = (unsigned short)keep;
+    link_leaf(x, r);
+    insert_into_parent(x, key(r->values()[0]), r);
+    return r;
+}
+
+template <class Key, class Value, class KeyOfValue, class Compare, class Alloc, size_t NodeBytes>
+pair<typename btree<Key, Value, KeyOfValue, Compare, Alloc, NodeBytes>::iterator, bool>
+btree<Key, Value, KeyOfValue, Compare, Alloc, NodeBytes>::insert_unique(const value_type& v)
+{
+    const Key& k = key(v);
+    if (root == 0)
+    {
+        leftmost = rightmost = create_leaf();
+        root = leftmost;
+    }
+
+    leaf_node* x = find_leaf(k);
+    size_type pos = search(x->values(), x->count, k, KeyOfValue(), false);
+    if (pos < x->count && !key_compare(k, key(x->values()[pos])))
+    {
+        return pair<iterator, bool>(iterator(x, pos), false);
+    }
+
+    if (x->count == size_type(leaf_slots))
+    {
+        leaf_node* r = split_leaf(x);
+        if (pos > x->count)
+        {
+            pos -= x->count;
+            x = r;
+        }
+    }
+
+    Value* values = x->values();
+    __btree_relocate(values + pos + 1, values + pos, x->count - pos);
+    try
+    {
+        construct(values + pos, v);
+    }
+    catch (...)
+    {
+        //commit or rollback
+        __btree_relocate(values + pos, values + pos + 1, x->count - pos);
+        throw;
+    }
+    ++x->count;
+    ++node_count;
+    return pair<iterator, bool>(iterator(x, pos), true);
+}
+
+//ɾڲڵpĵposұߵӽڵ
+template <class Key, class Value, class KeyOfValue, class Compare, class Alloc, size_t NodeBytes>
+void btree<Key, Value, KeyOfValue, Compare, Alloc, NodeBytes>::remove_from_internal(internal_node* p, size_type pos)
+{
+    Key* keys = p->keys();
+    ::destroy(keys + pos);
+    __btree_relocate(keys + pos, keys + pos + 1, p->count - pos - 1);
+    memmove(p->children + pos + 1, p->children + pos + 2, (p->count - pos - 1) * sizeof(base_ptr));
+    --p->count;
+    adopt(p, pos + 1);
+}
+
+//ҶڵxֵܽڵиͽһֵֵܺϲϲӸڵɾһָ
+template <class Key, class Value, class KeyOfValue, class Compare, class Alloc, size_t NodeBytes>
+void btree<Key, Value, KeyOfValue, Compare, Alloc, NodeBytes>::rebalance_leaf(leaf_node* x)
+{
+    internal_node* p = (internal_node*)x->parent;
+    size_type i = x->position;
+    leaf_node* l = i > 0 ? (leaf_node*)p->children[i - 1] : 0;
+    leaf_node* r = i < p->count ? (leaf_node*)p->children[i + 1] : 0;
+
+    if (l != 0 && l->count > size_type(leaf_min))
+    {
+        __btree_relocate(x->values() + 1, x->values(), x->count);
+        __btree_relocate(x->values(), l->values() + l->count - 1, 1);
+        --l->count;
+        ++x->count;
+        p->keys()[i - 1] = key(x->values()[0]);
+        return;
+    }
+    if (r != 0 && r->count > size_type(leaf_min))
+    {
+        __btree_relocate(x->values() + x->count, r->values(), 1);
+        __btree_relocate(r->values(), r->values() + 1, r->count - 1);
+        --r->count;
+        ++x->count;
+        p->keys()[i] = key(r->values()[0]);
+        return;
+    }
+
+    //ڵleaf_slotsұߵĲ
+    if (l == 0)
+    {
+        l = x;
+        x = r;
+        ++i;
+    }
+    __btree_relocate(l->values() + l->count, x->values(), x->count);
+    l->count = (unsigned short)(l->count + x->count);
+    l->next = x->next;
+    if (x->next != 0)
+    {
+        x->next->prev = l;
+    }
+    else
+    {
+        rightmost = l;
+    }
+    leaf_pool.deallocate(x);
+    remove_from_internal(p, i - 1);
+    rebalance_internal(p);
+}
+
+template <class Key, class Value, class KeyOfValue, class Compare, class Alloc, size_t NodeBytes>
+void btree<Key, Value, KeyOfValue, Compare, Alloc, NodeBytes>::rebalance_internal(internal_node* p)
+{
+    if (p == root)
+    {
+        if (p->count == 0)
+        {
+            //ֻʣһӽڵ㣬һ
+            root = p->children[0];
+            root->parent = 0;
+            root->position = 0;
+            internal_pool.deallocate(p);
+        }
+        return;
+    }
+    if (p->count >= size_type(internal_min))
+    {
+        return;
+    }
+
+    internal_node* g = (internal_node*)p->parent;
+    size_type i = p->position;
+    internal_node* l = i > 0 ? (internal_node*)g->children[i - 1] : 0;
+    internal_node* r = i < g->count ? (internal_node*)g->children[i + 1] : 0;
+    Key* gk = g->keys();
+
+    if (l != 0 && l->count > size_type(internal_min))
+    {
+        //ڵķָƵpĿͷlһ
+        Key* pk = p->keys();
+        Key* lk = l->keys();
+        __btree_relocate(pk + 1, pk, p->count);
+        construct(pk, std::move(gk[i - 1]));
+        memmove(p->children + 1, p->children, (p->count + 1) * sizeof(base_ptr));
+        p->children[0] = l->children[l->count];
+        gk[i - 1] = std::move(lk[l->count - 1]);
+        ::destroy(lk + l->count - 1);
+        --l->count;
+        ++p->count;
+        adopt(p, 0);
+        return;
+    }
+    if (r != 0 && r->count > size_type(internal_min))
+    {
+        //ڵķָƵpĩβrĵһ
+        Key* pk = p->keys();
+        Key* rk = r->keys();
+        construct(pk + p->count, std::move(gk[i]));
+        p->children[p->count + 1] = r->children[0];
+        gk[i] = std::move(rk[0]);
+        ::destroy(rk);
+        __btree_relocate(rk, rk + 1, r->count - 1);
+        memmove(r->children, r->children + 1, r->count * sizeof(base_ptr));
+        --r->count;
+        ++p->count;
+        adopt(p, p->count);
+        adopt(r, 0);
+        return;
+    }
+
+    //ڵķָƣұ߽ڵļһ߽ڵ
+    if (l == 0)
+    {
+        l = p;
+        p = r;
+        ++i;
+    }
+    Key* lk = l->keys();
+    size_type old_count = l->count;
+    construct(lk + old_count, std::move(gk[i - 1]));
+    __btree_relocate(lk + old_count + 1, p->keys(), p->count);
+    memcpy(l->children + old_count + 1, p->children, (p->count + 1) * sizeof(base_ptr));
+    l->count = (unsigned short)(old_count + 1 + p->count);
+    adopt(l, old_count + 1);
+    internal_pool.deallocate(p);
+    remove_from_internal(g, i - 1);
+    rebalance_internal(g);
+}
+
+template <class Key, class Value, class KeyOfValue, class Compare, class Alloc, size_t NodeBytes>
+void btree<Key, Value, KeyOfValue, Compare, Alloc, NodeBytes>::erase(iterator position)
+{
+    leaf_node* x = position.node;
+    size_type pos = position.position;
+    Value* values = x->values();
+    ::destroy(values + pos);
+    __btree_relocate(values + pos, values + pos + 1, x->count - pos - 1);
+    --x->count;
+    --node_count;
+
+    //ɾֵʹĳָҲظĶָȻСڵұеļ
+    if (x == root)
+    {
+        if (x->count == 0)
+        {
+            leaf_pool.deallocate(x);
+            root = 0;
+            leftmost = 0;
+            rightmost = 0;
+        }
+        return;
+    }
+    if (x->count < size_type(leaf_min))
+    {
+        rebalance_leaf(x);
+    }
+}
+
+//ÿɾһֵʧЧԼļɾ¶λһֵ
+template <class Key, class Value, class KeyOfValue, class Compare, class Alloc, size_t NodeBytes>
+void btree<Key, Value, KeyOfValue, Compare, Alloc, NodeBytes>::erase(iterator first, iterator last)
+{
+    if (first == begin() && last == end())
+    {
+        clear();
+        return;
+    }
+    size_type n = 0;
+    for (iterator it = first; it != last; ++it)
+    {
+        ++n;
+    }
+    while (n-- != 0)
+    {
+        Key k(key(*first));
+        erase(first);
+        if (n != 0)
+        {
+            first = lower_bound(k);
+        }
+    }
+}
+
+template <class Key, class Value, class KeyOfValue, class Compare, class Alloc, size_t NodeBytes>
+void btree<Key, Value, KeyOfValue, Compare, Alloc, NodeBytes>::destroy_subtree(base_ptr x)
+{
+    if (x->leaf)
+    {
+        leaf_node* l = (leaf_node*)x;
+        ::destroy(l->values(), l->values() + l->count);
+        return;
+    }
+    internal_node* p = (internal_node*)x;
+    for (size_type i = 0; i <= p->count; ++i)
+    {
+        destroy_subtree(p->children[i]);
+    }
+    ::destroy(p->keys(), p->keys() + p->count);
+}
+
+//򼯺ϣӿmy_setͬԪز޸iteratorҲconst_iterator
+template <class Key, class Compare = std::less<Key>, class Alloc = my_alloc, size_t NodeBytes = 256>
+class my_btree_set
+{
+public:
+    typedef Key key_type;
+    typedef Key value_type;
+    typedef Compare key_compare;
+    typedef Compare value_compare;
+
+private:
+    typedef btree<key_type, value_type, my_identity<value_type>, key_compare, Alloc, NodeBytes> rep_type;
+    rep_type t;
+
+public:
+    typedef typename rep_type::const_pointer pointer;
+    typedef typename rep_type::const_pointer const_pointer;
+    typedef typename rep_type::const_reference reference;
+    typedef typename rep_type::const_reference const_reference;
+    typedef typename rep_type::const_iterator iterator;
+    typedef typename rep_type::const_iterator const_iterator;
+    typedef typename rep_type::const_reverse_iterator reverse_iterator;
+    typedef typename rep_type::const_reverse_iterator const_reverse_iterator;
+    typedef typename rep_type::size_type size_type;
+    typedef typename rep_type::difference_type difference_type;
+
+    my_btree_set() : t(Compare()) {}
+    explicit my_btree_set(const Compare& comp) : t(comp) {}
+    template <class InputIterator>
+    my_btree_set(InputIterator first, InputIterator last, const Compare& comp = Compare()) : t(comp)
+    {
+        t.insert_unique(first, last);
+    }
+
+    key_compare key_comp() const { return t.key_comp(); }
+    value_compare value_comp() const { return t.key_comp(); }
+    iterator begin() const { return t.begin(); }
+    iterator end() const { return t.end(); }
+    reverse_iterator rbegin() const { return t.rbegin(); }
+    reverse_iterator rend() const { return t.rend(); }
+    bool empty() const { return t.empty(); }
+    size_type size() const { return t.size(); }
+    void swap(my_btree_set& x) { t.swap(x.t); }
+
+    pair<iterator, bool> insert(const value_type& x)
+    {
+        pair<typename rep_type::iterator, bool> p = t.insert_unique(x);
+        return pair<iterator, bool>(p.first, p.second);
+    }
+    template <class InputIterator>
+    void insert(InputIterator first, InputIterator last)
+    {
+        t.insert_unique(first, last);
+    }
+    void erase(iterator position)
+    {
+        typedef typename rep_type::iterator rep_iterator;
+        t.erase(rep_iterator(position.node, position.position));
+    }
+    size_type erase(const key_type& x)
+    {
+        return t.erase(x);
+    }
+    void erase(iterator first, iterator last)
+    {
+        typedef typename rep_type::iterator rep_iterator;
+        t.erase(rep_iterator(first.node, first.position), rep_iterator(last.node, last.position));
+    }
+    void clear() { t.clear(); }
+
+    iterator find(const key_type& x) const { return t.find(x); }
+    size_type count(const key_type& x) const { return t.count(x); }
+    iterator lower_bound(const key_type& x) const { return t.lower_bound(x); }
+    iterator upper_bound(const key_type& x) const { return t.upper_bound(x); }
+    pair<iterator, iterator> equal_range(const key_type& x) const { return t.equal_range(x); }
+};
+
+//ӳ䣬ӿmy_mapͬ
+template <class Key, class T, class Compare = std::less<Key>, class Alloc = my_alloc, size_t NodeBytes = 256>
+class my_btree_map
+{
+public:
+    typedef Key key_type;
+    typedef T data_type;
+    typedef T mapped_type;
+    typedef pair<const Key, T> value_type;
+    typedef Compare key_compare;
+
+private:
+    typedef btree<key_type, value_type, my_select1st<value_type>, key_compare, Alloc, NodeBytes> rep_type;
+    rep_type t;
+
+public:
+    typedef typename rep_type::pointer pointer;
+    typedef typename rep_type::const_pointer const_pointer;
+    typedef typename rep_type::reference reference;
+    typedef typename rep_type::const_reference const_reference;
+    typedef typename rep_type::iterator iterator;
+    typedef typename rep_type::const_iterator const_iterator;
+    typedef typename rep_type::reverse_iterator reverse_iterator;
+    typedef typename rep_type::const_reverse_iterator const_reverse_iterator;
+    typedef typename rep_type::size_type size_type;
+    typedef typename rep_type::difference_type difference_type;
+
+    my_btree_map() : t(Compare()) {}
+    explicit my_btree_map(const Compare& comp) : t(comp) {}
+    template <class InputIterator>
+    my_btree_map(InputIterator first, InputIterator last, const Compare& comp = Compare()) : t(comp)
+    {
+        t.insert_unique(first, last);
+    }
+
+    key_compare key_comp() const { return t.key_comp(); }
+    iterator begin() { return t.begin(); }
+    const_iterator begin() const { return t.begin(); }
+    iterator end() { return t.end(); }
+    const_iterator end() const { return t.end(); }
+    reverse_iterator rbegin() { return t.rbegin(); }
+    const_reverse_iterator rbegin() const { return t.rbegin(); }
+    reverse_iterator rend() { return t.rend(); }
+    const_reverse_iterator rend() const { return t.rend(); }
+    bool empty() const { return t.empty(); }
+    size_type size() const { return t.size(); }
+    void swap(my_btree_map& x) { t.swap(x.t); }
+
+    //ʱT()ƶԪأصֻһ޸֮ǰЧ
+    T& operator[](const key_type& k)
+    {
+        return (*t.insert_unique(value_type(k, T())).first).second;
+    }
+
+    pair<iterator, bool> insert(const value_type& x)
+    {
+        return t.insert_unique(x);
+    }
+    template <class InputIterator>
+    void insert(InputIterator first, InputIterator last)
+    {
+        t.insert_unique(first, last);
+    }
+    void erase(iterator position) { t.erase(position); }
+    size_type erase(const key_type& x) { return t.erase(x); }
+    void erase(iterator first, iterator last) { t.erase(first, last); }
+    void clear() { t.clear(); }
+
+    iterator find(const key_type& x) { return t.find(x); }
+    const_iterator find(const key_type& x) const { return t.find(x); }
+    size_type count(const key_type& x) const { return t.count(x); }
+    iterator lower_bound(const key_type& x) { return t.lower_bound(x); }
+    const_iterator lower_bound(const key_type& x) const { return t.lower_bound(x); }
+    iterator upper_bound(const key_type& x) { return t.upper_bound(x); }
+    const_iterator upper_bound(const key_type& x) const { return t.upper_bound(x); }
+    pair<iterator, iterator> equal_range(const key_type& x) { return t.equal_range(x); }
+    pair<const_iterator, const_iterator> equal_range(const key_type& x) const { return t.equal_range(x); }
+};
+#endif //__MY_STL_BTREE_H
@@ -0,0 +1,204 @@
+#ifndef __MY_STL_CONCURRENT_MAP_H
+#define __MY_STL_CONCURRENT_MAP_H
+#include <functional>
+#include <mutex>
+#include <shared_mutex>
+#include <utility>
+#include "my_stl_alloc.h"
+#include "my_stl_construct.h"
+#include "my_stl_flat_map.h"
+#include "my_stl_tree.h"
+#include "my_stl_vector.h"
+using namespace std;
+
+//ķΧƬĲӳ䣺ʱķֽiƬ[bounds[i - 1], bounds[i])ڵļ
+//ÿƬһörb_treeһѶдҺͷΧɨֻȡɾֻڵһƬ
+//ֽٸı䣬λƬҪƬںҼֲʱ
+//ĬʹõһƬᱻͬ߳ͬʱ޸ģmy_allocfree listûм
+template <class Key, class T, class Compare = std::less<Key>, class Alloc = malloc_alloc>
+class my_concurrent_map
+{
+public:
+    typedef Key key_type;
+    typedef T mapped_type;
+    typedef pair<const Key, T> value_type;
+    typedef Compare key_compare;
+    typedef size_t size_type;
+
+protected:
+    typedef rb_tree<key_type, value_type, my_select1st<value_type>, key_compare, Alloc> tree_type;
+    typedef shared_timed_mutex lock_type;
+
+    struct shard
+    {
+        mutable lock_type lock;
+        tree_type tree;
+        char pad[64];   //ڷƬһƬһƬͷͬһcache line
+
+        explicit shard(const Compare& comp) : tree(comp) {}
+    };
+    typedef simple_alloc<shard, Alloc> shard_allocator;
+
+    my_vector<Key, Alloc> bounds;   //ķֽƬΪbounds.size() + 1
+    shard* shards;
+    size_type nshards;
+    Compare comp;
+
+    //kڵķƬkķֽ
+    shard& shard_of(const Key& k) const
+    {
+        return shards[__flat_upper_bound(bounds.begin(), bounds.size(), k, comp)];
+    }
+
+    void create_shards()
+    {
+        nshards = bounds.size() + 1;
+        shards = shard_allocator::allocate(nshards);
+        for (size_type i = 0; i < nshards; ++i)
+        {
+            construct(shards + i, comp);
+        }
+    }
+
+public:
+    //캯ֽʱֻһƬ
+    explicit my_concurrent_map(const Compare& c = Compare()) : shards(0), nshards(0), comp(c)
+    {
+        create_shards();
+    }
+    //[first, last)Ϊϸķֽ
+    template <class InputIterator>
+    my_concurrent_map(InputIterator first, InputIterator last, const Compare& c = Compare())
+        : shards(0), nshards(0), comp(c)
+    {
+        for (; first != last; ++first)
+        {
+            bounds.push_back(*first);
+        }
+        create_shards();
+    }
+
+    //ʱ̷߳
+    ~my_concurrent_map()
+    {
+        for (size_type i = 0; i < nshards; ++i)
+        {
+            ::destroy(shards + i);
+        }
+        shard_allocator::deallocate(shards, nshards);
+    }
+
+    my_concurrent_map(const my_concurrent_map&) = delete;
+    my_concurrent_map& operator=(const my_concurrent_map&) = delete;
+
+    size_type shard_count() const
+    {
+        return nshards;
+    }
+
+    //ѴʱǣǷ
+    bool insert(const value_type& v)
+    {
+        shard& s = shard_of(v.first);
+        unique_lock<lock_type> guard(s.lock);
+        return s.tree.insert_unique(v).second;
+    }
+    //ѴʱԭֵǷ²
+    bool insert_or_assign(const Key& k, const T& x)
+    {
+        shard& s = shard_of(k);
+        unique_lock<lock_type> guard(s.lock);
+        pair<typename tree_type::iterator, bool> p = s.tree.insert_unique(value_type(k, x));
+        if (!p.second)
+        {
+            (*p.first).second = x;
+        }
+        return p.second;
+    }
+    size_type erase(const Key& k)
+    {
+        shard& s = shard_of(k);
+        unique_lock<lock_type> guard(s.lock);
+        return s.tree.erase(k);
+    }
+
+    //Ԫؿʱ߳ɾԲҰֵƳǷص
+    bool find(const Key& k, T& out) const
+    {
+        shard& s = shard_of(k);
+        shared_lock<lock_type> guard(s.lock);
+        typename tree_type::const_iterator it = s.tree.find(k);
+        if (it == s.tree.end())
+        {
+            return false;
+        }
+        out = (*it).second;
+        return true;
+    }
+    size_type count(const Key& k) const
+    {
+        shard& s = shard_of(k);
+        shared_lock<lock_type> guard(s.lock);
+        return s.tree.count(k);
+    }
+
+    //ڶڶԼΪkԪصffвٷ
+    template <class Visitor>
+    bool visit(const Key& k, Visitor f) const
+    {
+        shard& s = shard_of(k);
+        shared_lock<lock_type> guard(s.lock);
+        typename tree_type::const_iterator it = s.tree.find(k);
+        if (it == s.tree.end())
+        {
+            return false;
+        }
+        f(*it);
+        return true;
+    }
+
+    //˳[lo, hi)ڵԪصfÿƬԼĶɨ裬طʵԪظ
+    //ƬμԿĲĳһʱ̵ĿգÿƬڲһµ
+    template <class Visitor>
+    size_type visit_range(const Key& lo, const Key& hi, Visitor f) const
+    {
+        if (!comp(lo, hi))
+        {
+            return 0;
+        }
+        size_type first = __flat_upper_bound(bounds.begin(), bounds.size(), lo, comp);
+        size_type last = __flat_upper_bound(bounds.begin(), bounds.size(), hi, comp);
+        size_type n = 0;
+        for (size_type i = first; i <= last && i < nshards; ++i)
+        {
+            shared_lock<lock_type> guard(shards[i].lock);
+            n += shards[i].tree.visit_range(lo, hi, f);
+        }
+        return n;
+    }
+
+    //ƬԪ֮ͣ޸ʱֻһֵ
+    size_type size() const
+    {
+        size_type n = 0;
+        for (size_type i = 0; i < nshards; ++i)
+        {
+            shared_lock<lock_type> guard(shards[i].lock);
+            n += shards[i].tree.size();
+        }
+        return n;
+    }
+    bool empty() const
+    {
+        return size() == 0;
+    }
+    void clear()
+    {
+        for (size_type i = 0; i < nshards; ++i)
+        {
+            unique_lock<lock_type> guard(shards[i].lock);
+            shards[i].tree.clear();
+        }
+    }
+};
+#endif //__MY_STL_CONCURRENT_MAP_H
@@ -0,0 +1,326 @@
+#ifndef __MY_STL_CONCURRENT_VECTOR_H
+#define __MY_STL_CONCURRENT_VECTOR_H
+#include <atomic>
+#include <iterator>
+#include <utility>
+#include "my_stl_alloc.h"
+#include "my_stl_construct.h"
+#include "my_stl_segmented_vector.h"
+using namespace std;
+
+//ֻ׷vectorpush_backfetch_addȡ±̻꣬߳ȴعԪ
+//洢ΪɶΣ0κ͵1δСΪfirst_segment_size֮ÿηԪشӲ
+//ɵһõ̷߳䣬compare_exchangeװ룬߳ͷԼǷ
+//ÿλһ״̬־ֻῴѾɵǰ׺ʱ׳쳣ĲλΪϣsize()Խʱ
+//Ĭʹõһmy_allocfree listûмܱ߳ͬʱʹ
+
+template <class T, class Alloc>
+class my_concurrent_vector;
+
+//λ״̬
+enum
+{
+    __cv_slot_constructing = 0,     //ȡδ
+    __cv_slot_live = 1,             //Ԫѹ첢
+    __cv_slot_dead = 2              //ʱ׳쳣λ
+};
+
+//ϵĲλᱻֻ֧˫ƶ
+template <class T, class Alloc, class Ref, class Ptr>
+struct __concurrent_vector_iterator
+{
+    typedef bidirectional_iterator_tag iterator_category;
+    typedef T value_type;
+    typedef Ptr pointer;
+    typedef Ref reference;
+    typedef size_t size_type;
+    typedef ptrdiff_t difference_type;
+    typedef __concurrent_vector_iterator self;
+    typedef const my_concurrent_vector<T, Alloc>* container_pointer;
+
+    container_pointer vec;
+    size_type index;
+
+    __concurrent_vector_iterator() : vec(0), index(0) {}
+    __concurrent_vector_iterator(container_pointer v, size_type i) : vec(v), index(i) {}
+
+    reference operator*() const
+    {
+        return (reference)(*vec)[index];
+    }
+    pointer operator->() const
+    {
+        return &(operator*());
+    }
+
+    self& operator++()
+    {
+        index = vec->skip_dead(index + 1);
+        return *this;
+    }
+    self operator++(int)
+    {
+        self tmp = *this;
+        ++*this;
+        return tmp;
+    }
+    self& operator--()
+    {
+        do
+        {
+            --index;
+        } while (vec->is_dead(index));
+        return *this;
+    }
+    self operator--(int)
+    {
+        self tmp = *this;
+        --*this;
+        return tmp;
+    }
+
+    //end()µ±֮вλϣԽԱȽϲλ֮λ
+    bool operator==(const self& x) const
+    {
+        return index == x.index || vec->skip_dead(index) == vec->skip_dead(x.index);
+    }
+    bool operator!=(const self& x) const
+    {
+        return !(*this == x);
+    }
+};
+
+template <class T, class Alloc = malloc_alloc>
+class my_concurrent_vector
+{
+public:
+    typedef T value_type;
+    typedef value_type* pointer;
+    typedef const value_type* const_pointer;
+    typedef value_type& reference;
+    typedef const value_type& const_reference;
+    typedef size_t size_type;
+    typedef ptrdiff_t difference_type;
+    typedef __concurrent_vector_iterator<T, Alloc, T&, T*> iterator;
+    typedef __concurrent_vector_iterator<T, Alloc, const T&, const T*> const_iterator;
+
+    enum { first_segment_size = __segmented_vector_buf_size(0, sizeof(T)) };
+
+protected:
+    typedef simple_alloc<char, Alloc> segment_allocator;
+    typedef atomic<unsigned char> flag_type;
+    enum { first_segment_shift = __segmented_vector_log2(first_segment_size) };
+    enum { max_segments = sizeof(size_type) * 8 - first_segment_shift + 1 };
+
+    atomic<size_type> reserved;     //ѾȡȥĲλ
+    mutable atomic<size_type> published;    //ȷȫɣɹϣǰ׺ȣֻ
+    atomic<pointer> segments[max_segments];     //ÿεԪش洢֮öεķ־
+
+    static size_type log2(size_type n)
+    {
+#if defined(__GNUC__)
+        return sizeof(unsigned long long) * 8 - 1 - __builtin_clzll(n);
+#else
+        size_type r = 0;
+        while (n >>= 1)
+        {
+            ++r;
+        }
+        return r;
+#endif
+    }
+
+    //±iڵĶ
+    static size_type segment_index_of(size_type i)
+    {
+        size_type t = i >> first_segment_shift;
+        return t == 0 ? 0 : log2(t) + 1;
+    }
+    //kεһԪص±
+    static size_type segment_base(size_type k)
+    {
+        return k == 0 ? 0 : (size_type(first_segment_size) << (k - 1));
+    }
+    static size_type segment_size(size_type k)
+    {
+        return k == 0 ? size_type(first_segment_size) : segment_base(k);
+    }
+    static size_type segment_bytes(size_type k)
+    {
+        return segment_size(k) * (sizeof(T) + sizeof(flag_type));
+    }
+    static flag_type* segment_flags(pointer seg, size_type k)
+    {
+        return (flag_type*)(seg + segment_size(k));
+    }
+
+    //λûʱԼһȥװ˾ͷԼģװõǷ
+    pointer segment_for(size_type k)
+    {
+        pointer seg = segments[k].load(memory_order_acquire);
+        if (seg != 0)
+        {
+            return seg;
+        }
+        pointer fresh = (pointer)segment_allocator::allocate(segment_bytes(k));
+        flag_type* flags = segment_flags(fresh, k);
+        for (size_type n = 0; n < segment_size(k); ++n)
+        {
+            new (flags + n) flag_type(__cv_slot_constructing);
+        }
+        if (segments[k].compare_exchange_strong(seg, fresh, memory_order_acq_rel, memory_order_acquire))
+        {
+            return fresh;
+        }
+        segment_allocator::deallocate((char*)fresh, segment_bytes(k));
+        return seg;
+    }
+
+    //λûʱλһڹ
+    unsigned char slot_state(size_type i) const
+    {
+        size_type k = segment_index_of(i);
+        pointer seg = segments[k].load(memory_order_acquire);
+        return seg == 0 ? (unsigned char)__cv_slot_constructing :
+            segment_flags(seg, k)[i - segment_base(k)].load(memory_order_acquire);
+    }
+
+    //ȡһλйԪأɺ÷־׳쳣ʱѲλΪ׳
+    template <class... Args>
+    size_type emplace_aux(Args&&... args)
+    {
+        size_type i = reserved.fetch_add(1, memory_order_relaxed);
+        size_type k = segment_index_of(i);
+        pointer seg = segment_for(k);
+        size_type offset = i - segment_base(k);
+        flag_type& flag = segment_flags(seg, k)[offset];
+        try
+        {
+            construct(seg + offset, std::forward<Args>(args)...);
+        }
+        catch (...)
+        {
+            flag.store(__cv_slot_dead, memory_order_release);
+            throw;
+        }
+        flag.store(__cv_slot_live, memory_order_release);
+        return i;
+    }
+
+public:
+    //캯
+    my_concurrent_vector() : reserved(0), published(0)
+    {
+        for (size_type k = 0; k < size_type(max_segments); ++k)
+        {
+            segments[k].store(0, memory_order_relaxed);
+        }
+    }
+
+    //ʱд
+    ~my_concurrent_vector()
+    {
+        size_type n = reserved.load(memory_order_acquire);
+        for (size_type i = 0; i < n; ++i)
+        {
+            if (slot_state(i) == __cv_slot_live)
+            {
+                ::destroy(&(*this)[i]);
+            }
+        }
+        for (size_type k = 0; k < size_type(max_segments); ++k)
+        {
+            pointer seg = segments[k].load(memory_order_relaxed);
+            if (seg != 0)
+            {
+                segment_allocator::deallocate((char*)seg, segment_bytes(k));
+            }
+        }
+    }
+
+    my_concurrent_vector(const my_concurrent_vector&) = delete;
+    my_concurrent_vector& operator=(const my_concurrent_vector&) = delete;
+
+    //Ԫص±
+    size_type push_back(const T& x)
+    {
+        return emplace_aux(x);
+    }
+    template <class... Args>
+    size_type emplace_back(Args&&... args)
+    {
+        return emplace_aux(std::forward<Args>(args)...);
+    }
+
+    //ɣɹϣǰ׺ȣϴεĽʼ־̯O(1)
+    //ǰ׺ϵĲλʱsize()±ϽԪظ
+    size_type size() const
+    {
+        size_type n = published.load(memory_order_acquire);
+        size_type limit = reserved.load(memory_order_acquire);
+        size_type i = n;
+        while (i < limit && slot_state(i) != __cv_slot_constructing)
+        {
+            ++i;
+        }
+        while (i > n && !published.compare_exchange_weak(n, i, memory_order_release, memory_order_acquire))
+        {
+            //ѾƽøԶֱӲĽ
+        }
+        return i > n ? i : n;
+    }
+    //ڹеĲλ
+    size_type reserved_size() const
+    {
+        return reserved.load(memory_order_acquire);
+    }
+    bool empty() const
+    {
+        return begin() == end();
+    }
+    //ʱ׳쳣Ĳλ
+    bool is_dead(size_type i) const
+    {
+        return slot_state(i) == __cv_slot_dead;
+    }
+    //±iʼϵĲλ
+    size_type skip_dead(size_type i) const
+    {
+        while (is_dead(i))
+        {
+            ++i;
+        }
+        return i;
+    }
+
+    //ֻܷ±Сsize()ûϵԪأpush_backص±ǿԷ
+    reference operator[](size_type i)
+    {
+        size_type k = segment_index_of(i);
+        return segments[k].load(memory_order_acquire)[i - segment_base(k)];
+    }
+    const_reference operator[](size_type i) const
+    {
+        size_type k = segment_index_of(i);
+        return segments[k].load(memory_order_acquire)[i - segment_base(k)];
+    }
+
+    //end()ȡʱѷǰ׺ڼ׷ӵԪزᱻ
+    iterator begin()
+    {
+        return iterator(this, skip_dead(0));
+    }
+    iterator end()
+    {
+        return iterator(this, size());
+    }
+    const_iterator begin() const
+    {
+        return const_iterator(this, skip_dead(0));
+    }
+    const_iterator end() const
+    {
+        return const_iterator(this, size());
+    }
+};
+#endif //__MY_STL_CONCURRENT_VECTOR_H
@@ -4,6 +4,7 @@
 #include <new>
 #include <type_traits>
 #include <iterator>
+#include <utility>
 using namespace std;
 //캯
 template <class T1, class T2>
@@ -12,6 +13,13 @@ inline void construct(T1 *p, const T2 &value)
     new (p) T1(value);
 }
 
+//ԭع죬emplaceϵʹ
+template <class T1, class... Args>
+inline void construct(T1 *p, Args&&... args)
+{
+    new (p) T1(std::forward<Args>(args)...);
+}
+
 //
 template <class ForwardIterator> inline void __destroy_aux(ForwardIterator first, ForwardIterator last, true_type);
 template <class ForwardIterator> inline void __destroy_aux(ForwardIterator first, ForwardIterator last, false_type);
@@ -0,0 +1,405 @@
+#ifndef __MY_STL_FLAT_MAP_H
+#define __MY_STL_FLAT_MAP_H
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <utility>
+#include "my_stl_alloc.h"
+#include "my_stl_vector.h"
+using namespace std;
+
+//vectorʵֵӳ䣺ֱֵmy_vectorУ±ͬļֵһ
+//ֻļ޷֧֣ÿԪֻռsizeof(Key) + sizeof(T)
+//ɾҪƺԪأʺϽúԲѯΪĲұȥԪع鲢
+
+//[first, first + n)еһСkλãÿֻһαȽѡһε㣬ûԤת
+template <class Key, class Compare>
+inline size_t __flat_lower_bound(const Key* first, size_t n, const Key& k, const Compare& comp)
+{
+    if (n == 0)
+    {
+        return 0;
+    }
+    const Key* base = first;
+    while (n > 1)
+    {
+        size_t half = n / 2;
+        base = comp(base[half], k) ? base + half : base;
+        n -= half;
+    }
+    return (base - first) + comp(*base, k);
+}
+
+//صһkλ
+template <class Key, class Compare>
+inline size_t __flat_upper_bound(const Key* first, size_t n, const Key& k, const Compare& comp)
+{
+    if (n == 0)
+    {
+        return 0;
+    }
+    const Key* base = first;
+    while (n > 1)
+    {
+        size_t half = n / 2;
+        base = !comp(k, base[half]) ? base + half : base;
+        n -= half;
+    }
+    return (base - first) + !comp(k, *base);
+}
+
+//ֵһţԽõõһ
+template <class Key, class T, class Ref, class Ptr>
+struct __flat_map_iterator
+{
+    typedef random_access_iterator_tag iterator_category;
+    typedef pair<Key, T> value_type;
+    typedef pair<const Key&, Ref> reference;
+    typedef ptrdiff_t difference_type;
+    typedef __flat_map_iterator<Key, T, T&, T*> iterator;
+    typedef __flat_map_iterator self;
+
+    //operator->Ҫһȡ->Ķ
+    struct pointer
+    {
+        reference ref;
+        const reference* operator->() const
+        {
+            return &ref;
+        }
+    };
+
+    const Key* key_ptr;
+    Ptr value_ptr;
+
+    __flat_map_iterator() : key_ptr(0), value_ptr(0) {}
+    __flat_map_iterator(const Key* k, Ptr v) : key_ptr(k), value_ptr(v) {}
+    __flat_map_iterator(const iterator& x) : key_ptr(x.key_ptr), value_ptr(x.value_ptr) {}
+
+    reference operator*() const
+    {
+        return reference(*key_ptr, *value_ptr);
+    }
+    pointer operator->() const
+    {
+        pointer p = { operator*() };
+        return p;
+    }
+
+    self& operator++() { ++key_ptr; ++value_ptr; return *this; }
+    self operator++(int) { self tmp = *this; ++*this; return tmp; }
+    self& operator--() { --key_ptr; --value_ptr; return *this; }
+    self operator--(int) { self tmp = *this; --*this; return tmp; }
+    self& operator+=(difference_type n) { key_ptr += n; value_ptr += n; return *this; }
+    self& operator-=(difference_type n) { key_ptr -= n; value_ptr -= n; return *this; }
+    self operator+(difference_type n) const { return self(key_ptr + n, value_ptr + n); }
+    self operator-(difference_type n) const { return self(key_ptr - n, value_ptr - n); }
+    difference_type operator-(const self& x) const
+    {
+        return key_ptr - x.key_ptr;
+    }
+    reference operator[](difference_type n) const
+    {
+        return *(*this + n);
+    }
+
+    bool operator==(const self& x) const { return key_ptr == x.key_ptr; }
+    bool operator!=(const self& x) const { return key_ptr != x.key_ptr; }
+    bool operator<(const self& x) const { return key_ptr < x.key_ptr; }
+};
+
+template <class Key, class T, class Compare = std::less<Key>, class Alloc = my_alloc>
+class my_flat_map
+{
+public:
+    typedef Key key_type;
+    typedef T mapped_type;
+    typedef pair<Key, T> value_type;
+    typedef Compare key_compare;
+    typedef size_t size_type;
+    typedef ptrdiff_t difference_type;
+    typedef __flat_map_iterator<Key, T, T&, T*> iterator;
+    typedef __flat_map_iterator<Key, T, const T&, const T*> const_iterator;
+
+    class value_compare
+    {
+        friend class my_flat_map<Key, T, Compare, Alloc>;
+    protected:
+        Compare comp;
+        value_compare(Compare c) : comp(c) {}
+    public:
+        bool operator()(const value_type& x, const value_type& y) const
+        {
+            return comp(x.first, y.first);
+        }
+    };
+
+protected:
+    my_vector<Key, Alloc> key_store;    //Ҳظļ
+    my_vector<T, Alloc> value_store;    //value_store[i]key_store[i]Ӧֵ
+    Compare comp;
+
+    const Key* key_data() const
+    {
+        return key_store.begin();
+    }
+    size_type lower_index(const Key& k) const
+    {
+        return __flat_lower_bound(key_data(), key_store.size(), k, comp);
+    }
+    size_type upper_index(const Key& k) const
+    {
+        return __flat_upper_bound(key_data(), key_store.size(), k, comp);
+    }
+    iterator make_iterator(size_type i)
+    {
+        return iterator(key_store.begin() + i, value_store.begin() + i);
+    }
+    const_iterator make_iterator(size_type i) const
+    {
+        return const_iterator(key_store.begin() + i, value_store.begin() + i);
+    }
+
+    //ȶȥظļظʱȳֵǸinsertĽͬ
+    void sort_unique(my_vector<value_type, Alloc>& v) const
+    {
+        stable_sort(v.begin(), v.end(), value_comp());
+        typename my_vector<value_type, Alloc>::iterator i = v.begin();
+        typename my_vector<value_type, Alloc>::iterator last = v.end();
+        if (i != last)
+        {
+            typename my_vector<value_type, Alloc>::iterator result = i;
+            while (++i != last)
+            {
+                if (comp(result->first, i->first))
+                {
+                    *++result = *i;
+                }
+            }
+            v.erase(++result, last);
+        }
+    }
+
+    void merge_sorted(const my_vector<value_type, Alloc>& batch);
+
+public:
+    //캯
+    my_flat_map(const Compare& c = Compare()) : comp(c) {}
+    template <class InputIterator>
+    my_flat_map(InputIterator first, InputIterator last, const Compare& c = Compare()) : comp(c)
+    {
+        insert(first, last);
+    }
+
+    my_flat_map(const my_flat_map&) = delete;
+    my_flat_map& operator=(const my_flat_map&) = delete;
+
+    key_compare key_comp() const
+    {
+        return comp;
+    }
+    value_compare value_comp() const
+    {
+        return value_compare(comp);
+    }
+
+    iterator begin()
+    {
+        return make_iterator(0);
+    }
+    iterator end()
+    {
+        return make_iterator(size());
+    }
+    const_iterator begin() const
+    {
+        return make_iterator(0);
+    }
+    const_iterator end() const
+    {
+        return make_iterator(size());
+    }
+    size_type size() const
+    {
+        return key_store.size();
+    }
+    bool empty() const
+    {
+        return key_store.empty();
+    }
+    void reserve(size_type n)
+    {
+        key_store.reserve(n);
+        value_store.reserve(n);
+    }
+    void clear()
+    {
+        key_store.clear();
+        value_store.clear();
+    }
+    void swap(my_flat_map& x)
+    {
+        key_store.swap(x.key_store);
+        value_store.swap(x.value_store);
+        std::swap(comp, x.comp);
+    }
+
+    iterator lower_bound(const Key& k)
+    {
+        return make_iterator(lower_index(k));
+    }
+    const_iterator lower_bound(const Key& k) const
+    {
+        return make_iterator(lower_index(k));
+    }
+    iterator upper_bound(const Key& k)
+    {
+        return make_iterator(upper_index(k));
+    }
+    const_iterator upper_bound(const Key& k) const
+    {
+        return make_iterator(upper_index(k));
+    }
+    pair<iterator, iterator> equal_range(const Key& k)
+    {
+        return pair<iterator, iterator>(lower_bound(k), upper_bound(k));
+    }
+    pair<const_iterator, const_iterator> equal_range(const Key& k) const
+    {
+        return pair<const_iterator, const_iterator>(lower_bound(k), upper_bound(k));
+    }
+    iterator find(const Key& k)
+    {
+        size_type i = lower_index(k);
+        return (i == size() || comp(k, key_store[i])) ? end() : make_iterator(i);
+    }
+    const_iterator find(const Key& k) const
+    {
+        size_type i = lower_index(k);
+        return (i == size() || comp(k, key_store[i])) ? end() : make_iterator(i);
+    }
+    size_type count(const Key& k) const
+    {
+        return find(k) == end() ? 0 : 1;
+    }
+
+    //ʱֱ˳
+    T& at(const Key& k)
+    {
+        iterator it = find(k);
+        if (it == end())
+        {
+            std::cerr << "my_flat_map::at: key not found" << std::endl;
+            exit(1);
+        }
+        return *it.value_ptr;
+    }
+    const T& at(const Key& k) const
+    {
+        const_iterator it = find(k);
+        if (it == end())
+        {
+            std::cerr << "my_flat_map::at: key not found" << std::endl;
+            exit(1);
+        }
+        return *it.value_ptr;
+    }
+    T& operator[](const Key& k)
+    {
+        return *insert(value_type(k, T())).first.value_ptr;
+    }
+
+    //Ѵʱԭֵ
+    pair<iterator, bool> insert(const value_type& x)
+    {
+        size_type i = lower_index(x.first);
+        if (i != size() && !comp(x.first, key_store[i]))
+        {
+            return pair<iterator, bool>(make_iterator(i), false);
+        }
+        key_store.insert(key_store.begin() + i, x.first);
+        value_store.insert(value_store.begin() + i, x.second);
+        return pair<iterator, bool>(make_iterator(i), true);
+    }
+
+    //룺ȥغԪһι鲢O(n + m log m)
+    template <class InputIterator>
+    void insert(InputIterator first, InputIterator last)
+    {
+        my_vector<value_type, Alloc> batch;
+        for (; first != last; ++first)
+        {
+            batch.push_back(value_type(first->first, first->second));
+        }
+        if (!batch.empty())
+        {
+            sort_unique(batch);
+            merge_sorted(batch);
+        }
+    }
+
+    void erase(iterator position)
+    {
+        size_type i = position.key_ptr - key_data();
+        key_store.erase(key_store.begin() + i);
+        value_store.erase(value_store.begin() + i);
+    }
+    size_type erase(const Key& k)
+    {
+        iterator it = find(k);
+        if (it == end())
+        {
+            return 0;
+        }
+        erase(it);
+        return 1;
+    }
+};
+
+//batchѾҲظļ鲢µĴ洢к滻߶еļԭֵ
+template <class Key, class T, class Compare, class Alloc>
+void my_flat_map<Key, T, Compare, Alloc>::merge_sorted(const my_vector<value_type, Alloc>& batch)
+{
+    const size_type n = size();
+    const size_type m = batch.size();
+    my_vector<Key, Alloc> new_keys;
+    my_vector<T, Alloc> new_values;
+    new_keys.reserve(n + m);
+    new_values.reserve(n + m);
+
+    size_type i = 0;
+    size_type j = 0;
+    while (i < n && j < m)
+    {
+        if (comp(batch[j].first, key_store[i]))
+        {
+            new_keys.push_back(batch[j].first);
+            new_values.push_back(batch[j].second);
+            ++j;
+        }
+        else
+        {
+            if (!comp(key_store[i], batch[j].first))
+            {
+                ++j;
+            }
+            new_keys.push_back(key_store[i]);
+            new_values.push_back(value_store[i]);
+            ++i;
+        }
+    }
+    for (; i < n; ++i)
+    {
+        new_keys.push_back(key_store[i]);
+        new_values.push_back(value_store[i]);
+    }
+    for (; j < m; ++j)
+    {
+        new_keys.push_back(batch[j].first);
+        new_values.push_back(batch[j].second);
+    }
+
+    key_store.swap(new_keys);
+    value_store.swap(new_values);
+}
+#endif //__MY_STL_FLAT_MAP_H
@@ -0,0 +1,304 @@
+#ifndef __MY_STL_FROZEN_TREE_H
+#define __MY_STL_FROZEN_TREE_H
+#include <iterator>
+#include <stddef.h>
+#include <utility>
+#include "my_stl_alloc.h"
+#include "my_stl_construct.h"
+#include "my_stl_tree.h"
+using namespace std;
+
+//rb_treeֻգֵEytzinger˳ȫĲ򣩴ƽУ±1ʼ
+//±kӽڵ2k2k+1ʱ½Ҫӽڵָ룻ÿñȽϽһ±꣬ûԤת
+//漸㼯鿪ͷפ棬½ʱԤȡɲ֮ڵĻ
+
+//½kĶƱʾ¼·ȥĩβ1ߵĲһ0õһߵĽڵ
+inline size_t __eytzinger_unwind(size_t k)
+{
+#ifdef __GNUC__
+    return k >> (__builtin_ctzll(~(unsigned long long)k) + 1);
+#else
+    while (k & 1)
+    {
+        k >>= 1;
+    }
+    return k >> 1;
+#endif
+}
+
+//һ±꣬ûһʱ0
+inline size_t __eytzinger_next(size_t k, size_t n)
+{
+    if (2 * k + 1 <= n)
+    {
+        k = 2 * k + 1;
+        while (2 * k <= n)
+        {
+            k = 2 * k;
+        }
+        return k;
+    }
+    return __eytzinger_unwind(k);
+}
+
+//һ±꣬kΪ0endʱһ
+inline size_t __eytzinger_prev(size_t k, size_t n)
+{
+    if (k == 0)
+    {
+        k = n == 0 ? 0 : 1;
+        while (2 * k + 1 <= n)
+        {
+            k = 2 * k + 1;
+        }
+        return k;
+    }
+    if (2 * k <= n)
+    {
+        k = 2 * k;
+        while (2 * k + 1 <= n)
+        {
+            k = 2 * k + 1;
+        }
+        return k;
+    }
+    //߹еӣһڵ
+    while ((k & 1) == 0)
+    {
+        k >>= 1;
+    }
+    return k >> 1;
+}
+
+//ֻiteratorconst_iteratorͬһͣ±0ʾend
+template <class Value>
+struct __frozen_tree_iterator
+{
+    typedef bidirectional_iterator_tag iterator_category;
+    typedef Value value_type;
+    typedef const Value& reference;
+    typedef const Value* pointer;
+    typedef ptrdiff_t difference_type;
+    typedef __frozen_tree_iterator<Value> self;
+
+    const Value* values;
+    size_t n;
+    size_t k;
+
+    __frozen_tree_iterator() : values(0), n(0), k(0) {}
+    __frozen_tree_iterator(const Value* v, size_t count, size_t i) : values(v), n(count), k(i) {}
+
+    reference operator*() const
+    {
+        return values[k];
+    }
+    pointer operator->() const
+    {
+        return &(operator*());
+    }
+
+    self& operator++() { k = __eytzinger_next(k, n); return *this; }
+    self operator++(int) { self tmp = *this; ++*this; return tmp; }
+    self& operator--() { k = __eytzinger_prev(k, n); return *this; }
+    self operator--(int) { self tmp = *this; --*this; return tmp; }
+
+    bool operator==(const self& x) const { return k == x.k && values == x.values; }
+    bool operator!=(const self& x) const { return !(*this == x); }
+};
+
+template <class Key, class Value, class KeyOfValue, class Compare, class Alloc = my_alloc>
+class frozen_rb_tree
+{
+public:
+    typedef Key key_type;
+    typedef Value value_type;
+    typedef const value_type* pointer;
+    typedef const value_type* const_pointer;
+    typedef const value_type& reference;
+    typedef const value_type& const_reference;
+    typedef size_t size_type;
+    typedef ptrdiff_t difference_type;
+    typedef __frozen_tree_iterator<Value> iterator;
+    typedef __frozen_tree_iterator<Value> const_iterator;
+
+protected:
+    typedef simple_alloc<Key, Alloc> key_allocator;
+    typedef simple_alloc<Value, Alloc> value_allocator;
+
+    //һԤȡĲԤȡͬһ64ֽڵĻ
+    enum { prefetch_stride = sizeof(Key) <= 4 ? 16 : sizeof(Key) <= 8 ? 8 : sizeof(Key) <= 16 ? 4 : 2 };
+
+    Key* keys;          //keys[1..n]keys[0]
+    Value* values;      //values[k]keys[k]ڵֵ
+    size_type n;
+    size_type leftmost; //һԪص±
+    Compare key_compare;
+
+    template <class InputIterator>
+    void __fill(InputIterator& it, size_type k);
+
+    //صһСk±꣬ûʱ0
+    size_type lower_index(const Key& k) const
+    {
+        size_type i = 1;
+        while (i <= n)
+        {
+            size_type p = i * prefetch_stride;
+            __rb_tree_prefetch(keys + (p <= n ? p : 0));
+            i = 2 * i + key_compare(keys[i], k);
+        }
+        return __eytzinger_unwind(i);
+    }
+    //صһk±
+    size_type upper_index(const Key& k) const
+    {
+        size_type i = 1;
+        while (i <= n)
+        {
+            size_type p = i * prefetch_stride;
+            __rb_tree_prefetch(keys + (p <= n ? p : 0));
+            i = 2 * i + !key_compare(k, keys[i]);
+        }
+        return __eytzinger_unwind(i);
+    }
+    const_iterator make_iterator(size_type i) const
+    {
+        return const_iterator(values, n, i);
+    }
+
+public:
+    frozen_rb_tree(const Compare& comp = Compare()) : keys(0), values(0), n(0), leftmost(0), key_compare(comp) {}
+    //Ѱֵź[first, first + n)գO(n)
+    template <class InputIterator>
+    frozen_rb_tree(InputIterator first, size_type n, const Compare& comp = Compare());
+    frozen_rb_tree(frozen_rb_tree&& x)
+        : keys(x.keys), values(x.values), n(x.n), leftmost(x.leftmost), key_compare(x.key_compare)
+    {
+        x.keys = 0;
+        x.values = 0;
+        x.n = 0;
+        x.leftmost = 0;
+    }
+    frozen_rb_tree& operator=(frozen_rb_tree&& x)
+    {
+        swap(x);
+        return *this;
+    }
+    frozen_rb_tree(const frozen_rb_tree&) = delete;
+    frozen_rb_tree& operator=(const frozen_rb_tree&) = delete;
+    ~frozen_rb_tree();
+
+    Compare key_comp() const
+    {
+        return key_compare;
+    }
+    const_iterator begin() const
+    {
+        return make_iterator(leftmost);
+    }
+    const_iterator end() const
+    {
+        return make_iterator(0);
+    }
+    bool empty() const
+    {
+        return n == 0;
+    }
+    size_type size() const
+    {
+        return n;
+    }
+
+    const_iterator find(const Key& k) const
+    {
+        size_type i = lower_index(k);
+        return (i == 0 || key_compare(k, keys[i])) ? end() : make_iterator(i);
+    }
+    const_iterator lower_bound(const Key& k) const
+    {
+        return make_iterator(lower_index(k));
+    }
+    const_iterator upper_bound(const Key& k) const
+    {
+        return make_iterator(upper_index(k));
+    }
+    pair<const_iterator, const_iterator> equal_range(const Key& k) const
+    {
+        return pair<const_iterator, const_iterator>(lower_bound(k), upper_bound(k));
+    }
+    size_type count(const Key& k) const
+    {
+        size_type result = 0;
+        for (const_iterator i = lower_bound(k), last = upper_bound(k); i != last; ++i)
+        {
+            ++result;
+        }
+        return result;
+    }
+
+    void swap(frozen_rb_tree& x)
+    {
+        std::swap(keys, x.keys);
+        std::swap(values, x.values);
+        std::swap(n, x.n);
+        std::swap(leftmost, x.leftmost);
+        std::swap(key_compare, x.key_compare);
+    }
+};
+
+template <class Key, class Value, class KeyOfValue, class Compare, class Alloc>
+template <class InputIterator>
+frozen_rb_tree<Key, Value, KeyOfValue, Compare, Alloc>::frozen_rb_tree(InputIterator first, size_type n,
+    const Compare& comp) : keys(0), values(0), n(n), leftmost(0), key_compare(comp)
+{
+    if (n == 0)
+    {
+        return;
+    }
+    keys = key_allocator::allocate(n + 1);
+    values = value_allocator::allocate(n + 1);
+    //ȫ˳룬е˳
+    __fill(first, 1);
+    leftmost = 1;
+    while (2 * leftmost <= n)
+    {
+        leftmost *= 2;
+    }
+}
+
+template <class Key, class Value, class KeyOfValue, class Compare, class Alloc>
+template <class InputIterator>
+void frozen_rb_tree<Key, Value, KeyOfValue, Compare, Alloc>::__fill(InputIterator& it, size_type k)
+{
+    if (k > n)
+    {
+        return;
+    }
+    __fill(it, 2 * k);
+    construct(values + k, *it);
+    construct(keys + k, KeyOfValue()(values[k]));
+    ++it;
+    __fill(it, 2 * k + 1);
+}
+
+template <class Key, class Value, class KeyOfValue, class Compare, class Alloc>
+frozen_rb_tree<Key, Value, KeyOfValue, Compare, Alloc>::~frozen_rb_tree()
+{
+    if (n == 0)
+    {
+        return;
+    }
+    ::destroy(keys + 1, keys + n + 1);
+    ::destroy(values + 1, values + n + 1);
+    key_allocator::deallocate(keys, n + 1);
+    value_allocator::deallocate(values, n + 1);
+}
+
+template <class Key, class Value, class KeyOfValue, class Compare, class Alloc, class NodeUpdate, class Stats>
+frozen_rb_tree<Key, Value, KeyOfValue, Compare, Alloc>
+rb_tree<Key, Value, KeyOfValue, Compare, Alloc, NodeUpdate, Stats>::freeze() const
+{
+    return frozen_rb_tree<Key, Value, KeyOfValue, Compare, Alloc>(begin(), size(), key_compare);
+}
+
+#endif //__MY_STL_FROZEN_TREE_H
@@ -0,0 +1,654 @@
+#ifndef __MY_STL_HASHTABLE_H
+#define __MY_STL_HASHTABLE_H
+#include <functional>
+#include <iostream>
+#include <iterator>
+#include <stdint.h>
+#include <string.h>
+#include <utility>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+#include "my_stl_alloc.h"
+#include "my_stl_construct.h"
+using namespace std;
+
+//ŶַĹϣֱֵӷڲУһһһӦĿֽ
+//ֽΪʾղۻɾΪ0~127ʱǸòֵĹϣֵĵ7λh2
+//ϣֵಿ֣h1һ鿪ʼ̽飬ÿ16ֽһαȽϣƥh2Ĳ۲ȥȽϼ
+//ֻһֽںһۣпղʱ̽
+
+typedef signed char __ctrl_t;
+enum
+{
+    __ctrl_empty = -128,    //ղ
+    __ctrl_deleted = -2,    //ɾ̽鲻ͣ
+    __ctrl_sentinel = -1    //ֽĩβڱߵend
+};
+
+//һ16ֽڣĵiλӦڵi
+struct __swiss_group
+{
+    enum { width = 16 };
+
+#ifdef __SSE2__
+    __m128i ctrl;
+
+    explicit __swiss_group(const __ctrl_t* p) : ctrl(_mm_loadu_si128((const __m128i*)p)) {}
+
+    uint32_t match(__ctrl_t h2) const
+    {
+        return (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), ctrl));
+    }
+    uint32_t match_empty() const
+    {
+        return match(__ctrl_empty);
+    }
+    //ղۺɾֵСڱ
+    uint32_t match_empty_or_deleted() const
+    {
+        return (uint32_t)_mm_movemask_epi8(_mm_cmpgt_epi8(_mm_set1_epi8(__ctrl_sentinel), ctrl));
+    }
+#else
+    const __ctrl_t* ctrl;
+
+    explicit __swiss_group(const __ctrl_t* p) : ctrl(p) {}
+
+    uint32_t match(__ctrl_t h2) const
+    {
+        uint32_t mask = 0;
+        for (int i = 0; i < width; ++i)
+        {
+            mask |= uint32_t(ctrl[i] == h2) << i;
+        }
+        return mask;
+    }
+    uint32_t match_empty() const
+    {
+        return match(__ctrl_empty);
+    }
+    uint32_t match_empty_or_deleted() const
+    {
+        uint32_t mask = 0;
+        for (int i = 0; i < width; ++i)
+        {
+            mask |= uint32_t(ctrl[i] < __ctrl_sentinel) << i;
+        }
+        return mask;
+    }
+#endif
+};
+
+//͵1ڵλãmaskΪ0
+inline size_t __lowest_bit(uint32_t mask)
+{
+#ifdef __GNUC__
+    return __builtin_ctz(mask);
+#else
+    size_t i = 0;
+    while ((mask & 1) == 0)
+    {
+        mask >>= 1;
+        ++i;
+    }
+    return i;
+#endif
+}
+
+//std::hashǺӳ䣬λ͸λɢһѸλ۵
+inline size_t __hash_mix(size_t h)
+{
+    uint64_t m = (uint64_t)h * 0x9E3779B97F4A7C15ull;
+    return (size_t)(m ^ (m >> 32));
+}
+
+template <class Value, class Ref, class Ptr>
+struct __hashtable_iterator
+{
+    typedef forward_iterator_tag iterator_category;
+    typedef Value value_type;
+    typedef Ref reference;
+    typedef Ptr pointer;
+    typedef ptrdiff_t difference_type;
+    typedef __hashtable_iterator<Value, Value&, Value*> iterator;
+    typedef __hashtable_iterator self;
+
+    const __ctrl_t* ctrl;
+    Value* slot;
+
+    __hashtable_iterator() : ctrl(0), slot(0) {}
+    __hashtable_iterator(const __ctrl_t* c, Value* s) : ctrl(c), slot(s) {}
+    __hashtable_iterator(const iterator& x) : ctrl(x.ctrl), slot(x.slot) {}
+
+    reference operator*() const
+    {
+        return *slot;
+    }
+    pointer operator->() const
+    {
+        return &(operator*());
+    }
+
+    //ղۺɾĲۣͣһֵڱ
+    void skip_empty()
+    {
+        while (*ctrl < __ctrl_sentinel)
+        {
+            ++ctrl;
+            ++slot;
+        }
+    }
+    self& operator++()
+    {
+        ++ctrl;
+        ++slot;
+        skip_empty();
+        return *this;
+    }
+    self operator++(int)
+    {
+        self tmp = *this;
+        ++*this;
+        return tmp;
+    }
+
+    bool operator==(const self& x) const { return ctrl == x.ctrl; }
+    bool operator!=(const self& x) const { return ctrl != x.ctrl; }
+};
+
+template <class Value, class Key, class HashFcn, class ExtractKey, class EqualKey, class Alloc = my_alloc>
+class hashtable
+{
+public:
+    typedef Key key_type;
+    typedef Value value_type;
+    typedef HashFcn hasher;
+    typedef EqualKey key_equal;
+    typedef size_t size_type;
+    typedef ptrdiff_t difference_type;
+    typedef value_type* pointer;
+    typedef const value_type* const_pointer;
+    typedef value_type& reference;
+    typedef const value_type& const_reference;
+    typedef __hashtable_iterator<Value, Value&, Value*> iterator;
+    typedef __hashtable_iterator<Value, const Value&, const Value*> const_iterator;
+
+protected:
+    typedef simple_alloc<__ctrl_t, Alloc> ctrl_allocator;
+    typedef simple_alloc<Value, Alloc> slot_allocator;
+    enum { min_capacity = __swiss_group::width };
+
+    __ctrl_t* ctrl;         //capacity + 1ֽڣһڱ
+    Value* slots;
+    size_type capacity;     //02ݣҲСһ
+    size_type num_elements;
+    size_type growth_left;  //ݻռõĿղɾĲҲռ
+    float max_load;
+    hasher hash;
+    key_equal equals;
+    ExtractKey get_key;
+
+    //capacityΪ0ʱbeginendָڱ
+    static __ctrl_t* empty_ctrl()
+    {
+        static __ctrl_t sentinel = __ctrl_sentinel;
+        return &sentinel;
+    }
+    size_type growth_limit(size_type cap) const
+    {
+        return size_type(cap * max_load);
+    }
+    //nֵС
+    size_type capacity_for(size_type n) const
+    {
+        size_type cap = size_type(min_capacity);
+        while (growth_limit(cap) < n)
+        {
+            cap <<= 1;
+        }
+        return cap;
+    }
+    size_type group_mask() const
+    {
+        return capacity / size_type(__swiss_group::width) - 1;
+    }
+    static __ctrl_t h2(size_t h)
+    {
+        return __ctrl_t(h & 0x7f);
+    }
+    static size_t h1(size_t h)
+    {
+        return h >> 7;
+    }
+
+    void set_ctrl(size_type i, __ctrl_t c)
+    {
+        ctrl[i] = c;
+    }
+    //ҵһԷֵĲۣյĻɾģûʱcapacity
+    size_type find_non_full(size_t h) const;
+    //ңز۵±꣬Ҳʱcapacity
+    template <class K>
+    size_type find_index(const K& k, size_t h) const;
+    void initialize(size_type cap);
+    void resize(size_type new_capacity);
+    //ûпղۿʱɾĲ۽϶ͰԭɢУ
+    void make_room()
+    {
+        if (capacity != 0 && num_elements + 1 <= growth_limit(capacity) / 2)
+        {
+            resize(capacity);
+        }
+        else
+        {
+            size_type cap = capacity_for(num_elements + 1);
+            resize(cap > capacity * 2 ? cap : capacity * 2);
+        }
+    }
+    void destroy_slots();
+    void copy_from(const hashtable& x);
+
+    iterator make_iterator(size_type i)
+    {
+        return iterator(ctrl + i, slots + i);
+    }
+    const_iterator make_iterator(size_type i) const
+    {
+        return const_iterator(ctrl + i, slots + i);
+    }
+
+public:
+    explicit hashtable(size_type n = 0, const hasher& hf = hasher(), const key_equal& eql = key_equal())
+        : ctrl(empty_ctrl()), slots(0), capacity(0), num_elements(0), growth_left(0), max_load(0.875f),
+          hash(hf), equals(eql)
+    {
+        if (n > 0)
+        {
+            reserve(n);
+        }
+    }
+    hashtable(const hashtable& x)
+        : ctrl(empty_ctrl()), slots(0), capacity(0), num_elements(0), growth_left(0), max_load(x.max_load),
+          hash(x.hash), equals(x.equals), get_key(x.get_key)
+    {
+        copy_from(x);
+    }
+    hashtable& operator=(const hashtable& x)
+    {
+        if (this != &x)
+        {
+            clear();
+            hash = x.hash;
+            equals = x.equals;
+            max_load = x.max_load;
+            copy_from(x);
+        }
+        return *this;
+    }
+    ~hashtable();
+
+    hasher hash_funct() const
+    {
+        return hash;
+    }
+    key_equal key_eq() const
+    {
+        return equals;
+    }
+
+    iterator begin()
+    {
+        iterator it(ctrl, slots);
+        it.skip_empty();
+        return it;
+    }
+    iterator end()
+    {
+        return make_iterator(capacity);
+    }
+    const_iterator begin() const
+    {
+        const_iterator it(ctrl, slots);
+        it.skip_empty();
+        return it;
+    }
+    const_iterator end() const
+    {
+        return make_iterator(capacity);
+    }
+    size_type size() const
+    {
+        return num_elements;
+    }
+    bool empty() const
+    {
+        return num_elements == 0;
+    }
+    size_type max_size() const
+    {
+        return size_type(-1) / sizeof(Value);
+    }
+    //۵
+    size_type bucket_count() const
+    {
+        return capacity;
+    }
+    float load_factor() const
+    {
+        return capacity == 0 ? 0.0f : float(num_elements) / float(capacity);
+    }
+    float max_load_factor() const
+    {
+        return max_load;
+    }
+    //װӱ(0, 1]֮䣬޸ĺµ¼ʣĿղҪʱ
+    void max_load_factor(float f);
+    //֤ٲ뵽nֵ֮ǰ
+    void reserve(size_type n)
+    {
+        if (growth_limit(capacity) < n)
+        {
+            resize(capacity_for(n));
+        }
+    }
+    //ѲΪСn㹻ֵ2ݣͬʱɾ
+    void rehash(size_type n)
+    {
+        size_type cap = capacity_for(num_elements);
+        while (cap < n)
+        {
+            cap <<= 1;
+        }
+        resize(cap);
+    }
+
+    template <class K>
+    iterator find(const K& k)
+    {
+        size_type i = find_index(k, __hash_mix(hash(k)));
+        return i == capacity ? end() : make_iterator(i);
+    }
+    template <class K>
+    const_iterator find(const K& k) const
+    {
+        size_type i = find_index(k, __hash_mix(hash(k)));
+        return i == capacity ? end() : make_iterator(i);
+    }
+    size_type count(const key_type& k) const
+    {
+        return find(k) == end() ? 0 : 1;
+    }
+
+    //ʱargsڲйֵֻһιϣ̽һ
+    template <class K, class... Args>
+    pair<iterator, bool> emplace_unique_key(const K& k, Args&&... args);
+    pair<iterator, bool> insert_unique(const value_type& v)
+    {
+        return emplace_unique_key(get_key(v), v);
+    }
+    //ֵ֪֮ظʱֵ
+    template <class... Args>
+    pair<iterator, bool> emplace_unique(Args&&... args)
+    {
+        value_type v(std::forward<Args>(args)...);
+        return emplace_unique_key(get_key(v), std::move(v));
+    }
+    template <class InputIterator>
+    void insert_unique(InputIterator first, InputIterator last)
+    {
+        for (; first != last; ++first)
+        {
+            insert_unique(*first);
+        }
+    }
+
+    void erase(const_iterator position);
+    size_type erase(const key_type& k)
+    {
+        const_iterator it = find(k);
+        if (it == end())
+        {
+            return 0;
+        }
+        erase(it);
+        return 1;
+    }
+    void clear();
+    void swap(hashtable& x);
+};
+
+template <class Value, class Key, class HashFcn, class ExtractKey, class EqualKey, class Alloc>
+typename hashtable<Value, Key, HashFcn, ExtractKey, EqualKey, Alloc>::size_type
+hashtable<Value, Key, HashFcn, ExtractKey, EqualKey, Alloc>::find_non_full(size_t h) const
+{
+    size_type mask = group_mask();
+    size_type g = h1(h) & mask;
+    //2ݣ123...Ĳ߱е
+    for (size_type step = 1; step <= mask + 1; ++step)
+    {
+        size_type base = g * size_type(__swiss_group::width);
+        uint32_t m = __swiss_group(ctrl + base).match_empty_or_deleted();
+        if (m != 0)
+        {
+            return base + __lowest_bit(m);
+        }
+        g = (g + step) & mask;
+    }
+    return capacity;
+}
+
+template <class Value, class Key, class HashFcn, class ExtractKey, class EqualKey, class Alloc>
+template <class K>
+typename hashtable<Value, Key, HashFcn, ExtractKey, EqualKey, Alloc>::size_type
+hashtable<Value, Key, HashFcn, ExtractKey, EqualKey, Alloc>::find_index(const K& k, size_t h) const
+{
+    if (capacity == 0)
+    {
+        return 0;
+    }
+    size_type mask = group_mask();
+    size_type g = h1(h) & mask;
+    __ctrl_t tag = h2(h);
+    //װΪ1ʱûпղۣ̽ȫ
+    for (size_type step = 1; step <= mask + 1; ++step)
+    {
+        size_type base = g * size_type(__swiss_group::width);
+        __swiss_group group(ctrl + base);
+        for (uint32_t m = group.match(tag); m != 0; m &= m - 1)
+        {
+            size_type i = base + __lowest_bit(m);
+            if (equals(get_key(slots[i]), k))
+            {
+                return i;
+            }
+        }
+        if (group.match_empty() != 0)
+        {
+            break;
+        }
+        g = (g + step) & mask;
+    }
+    return capacity;
+}
+
+template <class Value, class Key, class HashFcn, class ExtractKey, class EqualKey, class Alloc>
+template <class K, class... Args>
+pair<typename hashtable<Value, Key, HashFcn, ExtractKey, EqualKey, Alloc>::iterator, bool>
+hashtable<Value, Key, HashFcn, ExtractKey, EqualKey, Alloc>::emplace_unique_key(const K& k, Args&&... args)
+{
+    size_t h = __hash_mix(hash(k));
+    size_type i = find_index(k, h);
+    if (i != capacity)
+    {
+        return pair<iterator, bool>(make_iterator(i), false);
+    }
+    i = find_non_full(h);
+    //ɾĲ۲ռµĿղ
+    if (i == capacity || (growth_left == 0 && ctrl[i] == __ctrl_empty))
+    {
+        make_room();
+        i = find_non_full(h);
+    }
+    construct(slots + i, std::forward<Args>(args)...);
+    growth_left -= ctrl[i] == __ctrl_empty;
+    set_ctrl(i, h2(h));
+    ++num_elements;
+    return pair<iterator, bool>(make_iterator(i), true);
+}
+
+template <class Value, class Key, class HashFcn, class ExtractKey, class EqualKey, class Alloc>
+void hashtable<Value, Key, HashFcn, ExtractKey, EqualKey, Alloc>::erase(const_iterator position)
+{
+    size_type i = position.ctrl - ctrl;
+    ::destroy(slots + i);
+    --num_elements;
+    //ڵﻹпղ˵û̽Խһ飬ֱӱɿղֵۣܾֻܱɾ
+    size_type base = i & ~size_type(__swiss_group::width - 1);
+    if (__swiss_group(ctrl + base).match_empty() != 0)
+    {
+        set_ctrl(i, __ctrl_empty);
+        ++growth_left;
+    }
+    else
+    {
+        set_ctrl(i, __ctrl_deleted);
+    }
+}
+
+template <class Value, class Key, class HashFcn, class ExtractKey, class EqualKey, class Alloc>
+void hashtable<Value, Key, HashFcn, ExtractKey, EqualKey, Alloc>::initialize(size_type cap)
+{
+    capacity = cap;
+    ctrl = ctrl_allocator::allocate(cap + 1);
+    slots = slot_allocator::allocate(cap);
+    memset(ctrl, __ctrl_empty, cap);
+    ctrl[cap] = __ctrl_sentinel;
+    num_elements = 0;
+    growth_left = growth_limit(cap);
+}
+
+//ɢеnew_capacityУֵƹȥɾı֮
+template <class Value, class Key, class HashFcn, class ExtractKey, class EqualKey, class Alloc>
+void hashtable<Value, Key, HashFcn, ExtractKey, EqualKey, Alloc>::resize(size_type new_capacity)
+{
+    __ctrl_t* old_ctrl = ctrl;
+    Value* old_slots = slots;
+    size_type old_capacity = capacity;
+    size_type n = num_elements;
+
+    initialize(new_capacity);
+    for (size_type i = 0; i < old_capacity; ++i)
+    {
+        if (old_ctrl[i] >= 0)
+        {
+            size_t h = __hash_mix(hash(get_key(old_slots[i])));
+            size_type j = find_non_full(h);
+            construct(slots + j, std::move(old_slots[i]));
+            ::destroy(old_slots + i);
+            set_ctrl(j, h2(h));
+        }
+    }
+    num_elements = n;
+    growth_left -= n;
+
+    if (old_capacity != 0)
+    {
+        ctrl_allocator::deallocate(old_ctrl, old_capacity + 1);
+        slot_allocator::deallocate(old_slots, old_capacity);
+    }
+}
+
+template <class Value, class Key, class HashFcn, class ExtractKey, class EqualKey, class Alloc>
+void hashtable<Value, Key, HashFcn, ExtractKey, EqualKey, Alloc>::max_load_factor(float f)
+{
+    if (!(f > 0.0f && f <= 1.0f))
+    {
+        std::cerr << "hashtable::max_load_factor: factor must be in (0, 1]" << std::endl;
+        exit(1);
+    }
+    max_load = f;
+    if (capacity != 0)
+    {
+        rehash(capacity_for(num_elements));
+    }
+}
+
+template <class Value, class Key, class HashFcn, class ExtractKey, class EqualKey, class Alloc>
+void hashtable<Value, Key, HashFcn, ExtractKey, EqualKey, Alloc>::destroy_slots()
+{
+    for (size_type i = 0; i < capacity; ++i)
+    {
+        if (ctrl[i] >= 0)
+        {
+            ::destroy(slots + i);
+        }
+    }
+}
+
+//xͲ۵λԭƣҪ¼ϣֵ
+template <class Value, class Key, class HashFcn, class ExtractKey, class EqualKey, class Alloc>
+void hashtable<Value, Key, HashFcn, ExtractKey, EqualKey, Alloc>::copy_from(const hashtable& x)
+{
+    if (x.capacity == 0)
+    {
+        return;
+    }
+    if (capacity != x.capacity)
+    {
+        if (capacity != 0)
+        {
+            ctrl_allocator::deallocate(ctrl, capacity + 1);
+            slot_allocator::deallocate(slots, capacity);
+        }
+        initialize(x.capacity);
+    }
+    memcpy(ctrl, x.ctrl, capacity + 1);
+    for (size_type i = 0; i < capacity; ++i)
+    {
+        if (ctrl[i] >= 0)
+        {
+            construct(slots + i, x.slots[i]);
+        }
+    }
+    num_elements = x.num_elements;
+    growth_left = x.growth_left;
+}
+
+template <class Value, class Key, class HashFcn, class ExtractKey, class EqualKey, class Alloc>
+void hashtable<Value, Key, HashFcn, ExtractKey, EqualKey, Alloc>::clear()
+{
+    if (capacity == 0)
+    {
+        return;
+    }
+    destroy_slots();
+    memset(ctrl, __ctrl_empty, capacity);
+    num_elements = 0;
+    growth_left = growth_limit(capacity);
+}
+
+template <class Value, class Key, class HashFcn, class ExtractKey, class EqualKey, class Alloc>
+hashtable<Value, Key, HashFcn, ExtractKey, EqualKey, Alloc>::~hashtable()
+{
+    if (capacity == 0)
+    {
+        return;
+    }
+    destroy_slots();
+    ctrl_allocator::deallocate(ctrl, capacity + 1);
+    slot_allocator::deallocate(slots, capacity);
+}
+
+template <class Value, class Key, class HashFcn, class ExtractKey, class EqualKey, class Alloc>
+void hashtable<Value, Key, HashFcn, ExtractKey, EqualKey, Alloc>::swap(hashtable& x)
+{
+    std::swap(ctrl, x.ctrl);
+    std::swap(slots, x.slots);
+    std::swap(capacity, x.capacity);
+    std::swap(num_elements, x.num_elements);
+    std::swap(growth_left, x.growth_left);
+    std::swap(max_load, x.max_load);
+    std::swap(hash, x.hash);
+    std::swap(equals, x.equals);
+}
+#endif //__MY_STL_HASHTABLE_H
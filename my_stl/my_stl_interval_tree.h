@@ -0,0 +1,137 @@
+#ifndef __MY_STL_INTERVAL_TREE_H
+#define __MY_STL_INTERVAL_TREE_H
+#include "my_stl_tree.h"
+
+//ֵһ[low, high]lowظÿڵ¼high
+//תͲɾ·__rb_tree_max_high_updateάhighСڲѯ¶ʱ
+//lowڲѯ϶ʱҲҳѯصkʵĽڵһΪO(min(n, k log n))
+//صlow˳ϼʱӽO(log n + k)
+//max_highsubtree_sizeһֱӸֵKeyƽƣͣ
+//άmax_highʱõĬϹCompareԱȽ׼״̬
+
+template <class Value, class Key>
+struct __rb_tree_interval_node : public __rb_tree_node<Value>
+{
+    Key max_high;   //highԼ
+};
+
+template <class Value, class Key, class HighOfValue, class Compare>
+struct __rb_tree_max_high_update
+{
+    typedef __rb_tree_interval_node<Value, Key> node_type;
+    enum { enabled = 1 };
+
+    static_assert(is_trivially_copyable<Key>::value, "interval endpoints must be trivially copyable");
+    static_assert(is_empty<Compare>::value, "interval tree comparator must be stateless");
+
+    static const Key& max_high(__rb_tree_node_base* x)
+    {
+        return ((node_type*)x)->max_high;
+    }
+
+    void operator()(__rb_tree_node_base* x) const
+    {
+        Compare comp;
+        const Key* m = &HighOfValue()(((node_type*)x)->value_field);
+        if (x->left != 0 && comp(*m, max_high(x->left)))
+        {
+            m = &max_high(x->left);
+        }
+        if (x->right != 0 && comp(*m, max_high(x->right)))
+        {
+            m = &max_high(x->right);
+        }
+        ((node_type*)x)->max_high = *m;
+    }
+};
+
+//KeyOfValueȡ¶ˣHighOfValueȡ϶ˣinsert_equal
+template <class Key, class Value, class KeyOfValue, class HighOfValue, class Compare, class Alloc = my_alloc>
+class interval_rb_tree
+    : public rb_tree<Key, Value, KeyOfValue, Compare, Alloc, __rb_tree_max_high_update<Value, Key, HighOfValue, Compare> >
+{
+protected:
+    typedef __rb_tree_max_high_update<Value, Key, HighOfValue, Compare> high_update;
+    typedef rb_tree<Key, Value, KeyOfValue, Compare, Alloc, high_update> base_type;
+    typedef typename base_type::link_type link_type;
+
+public:
+    typedef typename base_type::iterator iterator;
+    typedef typename base_type::const_iterator const_iterator;
+    typedef typename base_type::size_type size_type;
+
+    interval_rb_tree(const Compare& comp = Compare()) : base_type(comp) {}
+
+    //һ[lo, hi]ص䣬ûʱend()O(log n)
+    iterator find_overlap(const Key& lo, const Key& hi)
+    {
+        return iterator(__find_overlap(lo, hi));
+    }
+    const_iterator find_overlap(const Key& lo, const Key& hi) const
+    {
+        return const_iterator(__find_overlap(lo, hi));
+    }
+
+    //low˳ÿ[lo, hi]صf
+    template <class Visitor>
+    size_type visit_overlaps(const Key& lo, const Key& hi, Visitor f) const
+    {
+        size_type n = 0;
+        __visit_overlaps(this->root(), lo, hi, f, n);
+        return n;
+    }
+    //p
+    template <class Visitor>
+    size_type visit_stabbing(const Key& p, Visitor f) const
+    {
+        return visit_overlaps(p, p, f);
+    }
+
+protected:
+    //[low, high][lo, hi]صҽlow <= hihigh >= lo
+    bool overlaps(link_type x, const Key& lo, const Key& hi) const
+    {
+        return !this->key_compare(hi, base_type::key(x)) && !this->key_compare(HighOfValue()(x->value_field), lo);
+    }
+
+    link_type __find_overlap(const Key& lo, const Key& hi) const
+    {
+        link_type x = this->root();
+        while (x != 0 && !overlaps(x, lo, hi))
+        {
+            //϶˲СloʱصһҲ
+            if (x->left != 0 && !this->key_compare(high_update::max_high(x->left), lo))
+            {
+                x = base_type::left(x);
+            }
+            else
+            {
+                x = base_type::right(x);
+            }
+        }
+        return x == 0 ? this->header : x;
+    }
+
+    template <class Visitor>
+    void __visit_overlaps(link_type x, const Key& lo, const Key& hi, Visitor& f, size_type& n) const
+    {
+        //϶˶Сlo
+        if (x == 0 || this->key_compare(high_update::max_high(x), lo))
+        {
+            return;
+        }
+        __visit_overlaps(base_type::left(x), lo, hi, f, n);
+        //x¶˶hi
+        if (this->key_compare(hi, base_type::key(x)))
+        {
+            return;
+        }
+        if (!this->key_compare(HighOfValue()(x->value_field), lo))
+        {
+            f(x->value_field);
+            ++n;
+        }
+        __visit_overlaps(base_type::right(x), lo, hi, f, n);
+    }
+};
+#endif //__MY_STL_INTERVAL_TREE_H
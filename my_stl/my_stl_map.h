@@ -1,25 +1,14 @@
 #ifndef __MY_STL_MAP_H
 #define __MY_STL_MAP_H
-#include<functional>
+#include <algorithm>
+#include <functional>
+#include <initializer_list>
+#include <tuple>
+#include <utility>
 #include "my_stl_tree.h"
-template < class _Pair>
-struct _Select1st : public unary_function < _Pair, typename _Pair::first_type>
-{
-    typename _Pair::first_type &operator()(_Pair& __x) const
-    { return __x.first; }
-
-    const typename _Pair::first_type & operator()(const _Pair& __x) const
-    { return __x.first; }
-};
+#include "my_stl_frozen_tree.h"
+using namespace std;
 
-template < class _Pair>
-struct _Select2nd : public unary_function < _Pair, typename _Pair::second_type>
-{
-    typename _Pair::second_type& operator()(_Pair& __x) const
-    { return __x.second; }
-    const typename _Pair::second_type & operator()(const _Pair& __x) const
-    { return __x.second; }
-};
 template <class Key, class T, class Compare = std::less<Key>, class Alloc = my_alloc>
 class my_map
 {
@@ -30,7 +19,7 @@ public:
     typedef pair<const Key, T> value_type;
     typedef Compare key_compare;
 
-    class value_compare : public binary_function<value_type, value_type, bool>
+    class value_compare
     {
         friend class my_map<Key, T, Compare, Alloc>;
     protected:
@@ -44,7 +33,7 @@ public:
     };
 
 private:
-    typedef rb_tree<key_type, value_type, select1st<value_type>, key_compare, Alloc> rep_type;
+    typedef rb_tree<key_type, value_type, my_select1st<value_type>, key_compare, Alloc> rep_type;
     rep_type t;
 
 public:
@@ -58,20 +47,440 @@ public:
     typedef typename rep_type::const_reverse_iterator const_reverse_iterator;
     typedef typename rep_type::size_type size_type;
     typedef typename rep_type::difference_type difference_type;
+    typedef frozen_rb_tree<key_type, value_type, my_select1st<value_type>, key_compare, Alloc> frozen_type;
 
-    map() : t(Compare()) {}
-    explicit map(const Compare& comp) : t(comp) {}
+    my_map() : t(Compare()) {}
+    explicit my_map(const Compare& comp) : t(comp) {}
     template <class InputIterator>
-    map(InputIterator first, InputIterator last) : t(Compare())
+    my_map(InputIterator first, InputIterator last) : t(Compare())
     {
         t.insert_unique(first, last);
     }
     template <class InputIterator>
-    map(InputIterator first, InputIterator last, const Compare& comp) : t(comp)
+    my_map(InputIterator first, InputIterator last, const Compare& comp) : t(comp)
     {
         t.insert_unique(first, last);
     }
+    my_map(initializer_list<value_type> l, const Compare& comp = Compare()) : t(comp)
+    {
+        t.insert_unique(l.begin(), l.end());
+    }
+
+    key_compare key_comp() const { return t.key_comp(); }
+    value_compare value_comp() const { return value_compare(t.key_comp()); }
+    iterator begin() { return t.begin(); }
+    const_iterator begin() const { return t.begin(); }
+    iterator end() { return t.end(); }
+    const_iterator end() const { return t.end(); }
+    reverse_iterator rbegin() { return t.rbegin(); }
+    const_reverse_iterator rbegin() const { return t.rbegin(); }
+    reverse_iterator rend() { return t.rend(); }
+    const_reverse_iterator rend() const { return t.rend(); }
+    bool empty() const { return t.empty(); }
+    size_type size() const { return t.size(); }
+    size_type max_size() const { return t.max_size(); }
+
+    //ʱڽڵֱӹT()ֻ½һ
+    T& operator[](const key_type& k)
+    {
+        return (*t.emplace_unique_key(k, piecewise_construct, forward_as_tuple(k), tuple<>()).first).second;
+    }
+    T& operator[](key_type&& k)
+    {
+        return (*t.emplace_unique_key(k, piecewise_construct, forward_as_tuple(std::move(k)), tuple<>()).first).second;
+    }
+    //ʱֱ˳
+    T& at(const key_type& k)
+    {
+        iterator it = t.find(k);
+        if (it == end())
+        {
+            std::cerr << "my_map::at: key not found" << std::endl;
+            exit(1);
+        }
+        return (*it).second;
+    }
+    const T& at(const key_type& k) const
+    {
+        const_iterator it = t.find(k);
+        if (it == end())
+        {
+            std::cerr << "my_map::at: key not found" << std::endl;
+            exit(1);
+        }
+        return (*it).second;
+    }
+
+    //Ѵʱԭֵ
+    pair<iterator, bool> insert(const value_type& x)
+    {
+        return t.insert_unique(x);
+    }
+    pair<iterator, bool> insert(value_type&& x)
+    {
+        return t.emplace_unique_key(x.first, std::move(x));
+    }
+    iterator insert(iterator position, const value_type& x)
+    {
+        return t.insert_unique(position, x);
+    }
+    template <class InputIterator>
+    void insert(InputIterator first, InputIterator last)
+    {
+        t.insert_unique(first, last);
+    }
+    void insert(initializer_list<value_type> l)
+    {
+        t.insert_unique(l.begin(), l.end());
+    }
+    //argsڽڵйpairظʱõĽڵ㱻
+    template <class... Args>
+    pair<iterator, bool> emplace(Args&&... args)
+    {
+        return t.emplace_unique(std::forward<Args>(args)...);
+    }
+    //ʱargsڽڵйTѴʱargsᱻƶ
+    template <class... Args>
+    pair<iterator, bool> try_emplace(const key_type& k, Args&&... args)
+    {
+        return t.emplace_unique_key(k, piecewise_construct, forward_as_tuple(k),
+            forward_as_tuple(std::forward<Args>(args)...));
+    }
+    template <class... Args>
+    pair<iterator, bool> try_emplace(key_type&& k, Args&&... args)
+    {
+        return t.emplace_unique_key(k, piecewise_construct, forward_as_tuple(std::move(k)),
+            forward_as_tuple(std::forward<Args>(args)...));
+    }
+    //ʱ룬Ѵʱֵֻ½һ
+    template <class M>
+    pair<iterator, bool> insert_or_assign(const key_type& k, M&& obj)
+    {
+        pair<iterator, bool> r = t.emplace_unique_key(k, piecewise_construct, forward_as_tuple(k),
+            forward_as_tuple(std::forward<M>(obj)));
+        if (!r.second)
+        {
+            (*r.first).second = std::forward<M>(obj);
+        }
+        return r;
+    }
+    template <class M>
+    pair<iterator, bool> insert_or_assign(key_type&& k, M&& obj)
+    {
+        pair<iterator, bool> r = t.emplace_unique_key(k, piecewise_construct, forward_as_tuple(std::move(k)),
+            forward_as_tuple(std::forward<M>(obj)));
+        if (!r.second)
+        {
+            (*r.first).second = std::forward<M>(obj);
+        }
+        return r;
+    }
+
+    void erase(iterator position) { t.erase(position); }
+    size_type erase(const key_type& x) { return t.erase(x); }
+    void erase(iterator first, iterator last) { t.erase(first, last); }
+    void clear() { t.clear(); }
+
+    iterator find(const key_type& x) { return t.find(x); }
+    const_iterator find(const key_type& x) const { return t.find(x); }
+    size_type count(const key_type& x) const { return t.find(x) == t.end() ? 0 : 1; }
+    iterator lower_bound(const key_type& x) { return t.lower_bound(x); }
+    const_iterator lower_bound(const key_type& x) const { return t.lower_bound(x); }
+    iterator upper_bound(const key_type& x) { return t.upper_bound(x); }
+    const_iterator upper_bound(const key_type& x) const { return t.upper_bound(x); }
+    pair<iterator, iterator> equal_range(const key_type& x) { return t.equal_range(x); }
+    pair<const_iterator, const_iterator> equal_range(const key_type& x) const { return t.equal_range(x); }
+    //Ƚ׼is_transparentʱֱkey_typeȽϵͲ
+    template <class K, class C = Compare, class = typename C::is_transparent>
+    iterator find(const K& x) { return t.find(x); }
+    template <class K, class C = Compare, class = typename C::is_transparent>
+    const_iterator find(const K& x) const { return t.find(x); }
+    template <class K, class C = Compare, class = typename C::is_transparent>
+    size_type count(const K& x) const { return t.find(x) == t.end() ? 0 : 1; }
+    template <class K, class C = Compare, class = typename C::is_transparent>
+    iterator lower_bound(const K& x) { return t.lower_bound(x); }
+    template <class K, class C = Compare, class = typename C::is_transparent>
+    const_iterator lower_bound(const K& x) const { return t.lower_bound(x); }
+    template <class K, class C = Compare, class = typename C::is_transparent>
+    iterator upper_bound(const K& x) { return t.upper_bound(x); }
+    template <class K, class C = Compare, class = typename C::is_transparent>
+    const_iterator upper_bound(const K& x) const { return t.upper_bound(x); }
+    template <class K, class C = Compare, class = typename C::is_transparent>
+    pair<iterator, iterator> equal_range(const K& x) { return t.equal_range(x); }
+    template <class K, class C = Compare, class = typename C::is_transparent>
+    pair<const_iterator, const_iterator> equal_range(const K& x) const { return t.equal_range(x); }
+
+    //ֱӰƽڵ㣬rb_treeͬ
+    void split(const key_type& k, my_map& right) { t.split(k, right.t); }
+    void join(my_map& right) { t.join(right.t); }
+    void union_with(my_map& x) { t.union_with(x.t); }
+    void intersect_with(my_map& x) { t.intersect_with(x.t); }
+    void difference_with(my_map& x) { t.difference_with(x.t); }
+
+    //ֻEytzingerգfindlower_boundupper_bound͵my_mapһ£map
+    frozen_type freeze() const
+    {
+        return t.freeze();
+    }
+
+    //ĽṹзֺͲбrb_tree::split_rangeparallel_for_eachparallel_reduce
+    template <class OutputIterator>
+    OutputIterator split_range(size_type depth, OutputIterator out)
+    {
+        return t.split_range(depth, out);
+    }
+    template <class OutputIterator>
+    OutputIterator split_range(size_type depth, OutputIterator out) const
+    {
+        return t.split_range(depth, out);
+    }
+    template <class Function>
+    void parallel_for_each(Function f)
+    {
+        t.parallel_for_each(f);
+    }
+    template <class Function>
+    void parallel_for_each(Function f) const
+    {
+        t.parallel_for_each(f);
+    }
+    template <class U, class Accumulate, class Combine>
+    U parallel_reduce(U identity, Accumulate acc, Combine combine) const
+    {
+        return t.parallel_reduce(identity, acc, combine);
+    }
+    template <class U, class BinaryOperation>
+    U parallel_reduce(U identity, BinaryOperation op) const
+    {
+        return t.parallel_reduce(identity, op);
+    }
+
+    //keys[0..n)дoutrb_tree::find_batch
+    template <class RandomAccessIterator, class OutputIterator>
+    OutputIterator find_batch(RandomAccessIterator keys, size_type n, OutputIterator out)
+    {
+        return t.find_batch(keys, n, out);
+    }
+    template <class RandomAccessIterator, class OutputIterator>
+    OutputIterator find_batch(RandomAccessIterator keys, size_type n, OutputIterator out) const
+    {
+        return t.find_batch(keys, n, out);
+    }
+    //б浽ļʹO(n)ؽҪmy_stl_serialize.hrb_treesave_binaryload_binary
+    friend bool save_binary(const char* path, const my_map& x)
+    {
+        return save_binary(path, x.t);
+    }
+    friend bool load_binary(const char* path, my_map& x)
+    {
+        return load_binary(path, x.t, true);
+    }
+};
+
+template <class Key, class T, class Compare, class Alloc>
+inline bool operator==(const my_map<Key, T, Compare, Alloc>& x, const my_map<Key, T, Compare, Alloc>& y)
+{
+    return x.size() == y.size() && equal(x.begin(), x.end(), y.begin());
+}
+
+template <class Key, class T, class Compare, class Alloc>
+inline bool operator<(const my_map<Key, T, Compare, Alloc>& x, const my_map<Key, T, Compare, Alloc>& y)
+{
+    return lexicographical_compare(x.begin(), x.end(), y.begin(), y.end());
+}
+
+//ظӳ䣬ȵļȺ
+template <class Key, class T, class Compare = std::less<Key>, class Alloc = my_alloc>
+class my_multimap
+{
+public:
+    typedef Key key_type;
+    typedef T data_type;
+    typedef T mapped_type;
+    typedef pair<const Key, T> value_type;
+    typedef Compare key_compare;
+
+    class value_compare
+    {
+        friend class my_multimap<Key, T, Compare, Alloc>;
+    protected:
+        Compare comp;
+        value_compare(Compare c) : comp(c) {}
+    public:
+        bool operator()(const value_type &x, const value_type &y) const
+        {
+            return comp(x.first, y.first);
+        }
+    };
+
+private:
+    typedef rb_tree<key_type, value_type, my_select1st<value_type>, key_compare, Alloc> rep_type;
+    rep_type t;
+
+public:
+    typedef typename rep_type::pointer pointer;
+    typedef typename rep_type::const_pointer const_pointer;
+    typedef typename rep_type::reference reference;
+    typedef typename rep_type::const_reference const_reference;
+    typedef typename rep_type::iterator iterator;
+    typedef typename rep_type::const_iterator const_iterator;
+    typedef typename rep_type::reverse_iterator reverse_iterator;
+    typedef typename rep_type::const_reverse_iterator const_reverse_iterator;
+    typedef typename rep_type::size_type size_type;
+    typedef typename rep_type::difference_type difference_type;
+    typedef frozen_rb_tree<key_type, value_type, my_select1st<value_type>, key_compare, Alloc> frozen_type;
+
+    my_multimap() : t(Compare()) {}
+    explicit my_multimap(const Compare& comp) : t(comp) {}
+    template <class InputIterator>
+    my_multimap(InputIterator first, InputIterator last, const Compare& comp = Compare()) : t(comp)
+    {
+        t.insert_equal(first, last);
+    }
+    my_multimap(initializer_list<value_type> l, const Compare& comp = Compare()) : t(comp)
+    {
+        t.insert_equal(l.begin(), l.end());
+    }
+
+    key_compare key_comp() const { return t.key_comp(); }
+    value_compare value_comp() const { return value_compare(t.key_comp()); }
+    iterator begin() { return t.begin(); }
+    const_iterator begin() const { return t.begin(); }
+    iterator end() { return t.end(); }
+    const_iterator end() const { return t.end(); }
+    reverse_iterator rbegin() { return t.rbegin(); }
+    const_reverse_iterator rbegin() const { return t.rbegin(); }
+    reverse_iterator rend() { return t.rend(); }
+    const_reverse_iterator rend() const { return t.rend(); }
+    bool empty() const { return t.empty(); }
+    size_type size() const { return t.size(); }
+    size_type max_size() const { return t.max_size(); }
+
+    iterator insert(const value_type& x)
+    {
+        return t.insert_equal(x);
+    }
+    iterator insert(iterator position, const value_type& x)
+    {
+        return t.insert_equal(position, x);
+    }
+    template <class InputIterator>
+    void insert(InputIterator first, InputIterator last)
+    {
+        t.insert_equal(first, last);
+    }
+    void insert(initializer_list<value_type> l)
+    {
+        t.insert_equal(l.begin(), l.end());
+    }
+    template <class... Args>
+    iterator emplace(Args&&... args)
+    {
+        return t.emplace_equal(std::forward<Args>(args)...);
+    }
+
+    void erase(iterator position) { t.erase(position); }
+    size_type erase(const key_type& x) { return t.erase(x); }
+    void erase(iterator first, iterator last) { t.erase(first, last); }
+    void clear() { t.clear(); }
+
+    iterator find(const key_type& x) { return t.find(x); }
+    const_iterator find(const key_type& x) const { return t.find(x); }
+    size_type count(const key_type& x) const { return t.count(x); }
+    iterator lower_bound(const key_type& x) { return t.lower_bound(x); }
+    const_iterator lower_bound(const key_type& x) const { return t.lower_bound(x); }
+    iterator upper_bound(const key_type& x) { return t.upper_bound(x); }
+    const_iterator upper_bound(const key_type& x) const { return t.upper_bound(x); }
+    pair<iterator, iterator> equal_range(const key_type& x) { return t.equal_range(x); }
+    pair<const_iterator, const_iterator> equal_range(const key_type& x) const { return t.equal_range(x); }
+    //Ƚ׼is_transparentʱֱkey_typeȽϵͲ
+    template <class K, class C = Compare, class = typename C::is_transparent>
+    iterator find(const K& x) { return t.find(x); }
+    template <class K, class C = Compare, class = typename C::is_transparent>
+    const_iterator find(const K& x) const { return t.find(x); }
+    template <class K, class C = Compare, class = typename C::is_transparent>
+    size_type count(const K& x) const { return t.count(x); }
+    template <class K, class C = Compare, class = typename C::is_transparent>
+    iterator lower_bound(const K& x) { return t.lower_bound(x); }
+    template <class K, class C = Compare, class = typename C::is_transparent>
+    const_iterator lower_bound(const K& x) const { return t.lower_bound(x); }
+    template <class K, class C = Compare, class = typename C::is_transparent>
+    iterator upper_bound(const K& x) { return t.upper_bound(x); }
+    template <class K, class C = Compare, class = typename C::is_transparent>
+    const_iterator upper_bound(const K& x) const { return t.upper_bound(x); }
+    template <class K, class C = Compare, class = typename C::is_transparent>
+    pair<iterator, iterator> equal_range(const K& x) { return t.equal_range(x); }
+    template <class K, class C = Compare, class = typename C::is_transparent>
+    pair<const_iterator, const_iterator> equal_range(const K& x) const { return t.equal_range(x); }
 
-    
+    //ظֻṩзֺƴӣrb_treeͬ
+    void split(const key_type& k, my_multimap& right) { t.split(k, right.t); }
+    void join(my_multimap& right) { t.join(right.t); }
+
+    frozen_type freeze() const
+    {
+        return t.freeze();
+    }
+    template <class OutputIterator>
+    OutputIterator split_range(size_type depth, OutputIterator out)
+    {
+        return t.split_range(depth, out);
+    }
+    template <class OutputIterator>
+    OutputIterator split_range(size_type depth, OutputIterator out) const
+    {
+        return t.split_range(depth, out);
+    }
+    template <class Function>
+    void parallel_for_each(Function f)
+    {
+        t.parallel_for_each(f);
+    }
+    template <class Function>
+    void parallel_for_each(Function f) const
+    {
+        t.parallel_for_each(f);
+    }
+    template <class U, class Accumulate, class Combine>
+    U parallel_reduce(U identity, Accumulate acc, Combine combine) const
+    {
+        return t.parallel_reduce(identity, acc, combine);
+    }
+    template <class U, class BinaryOperation>
+    U parallel_reduce(U identity, BinaryOperation op) const
+    {
+        return t.parallel_reduce(identity, op);
+    }
+    template <class RandomAccessIterator, class OutputIterator>
+    OutputIterator find_batch(RandomAccessIterator keys, size_type n, OutputIterator out)
+    {
+        return t.find_batch(keys, n, out);
+    }
+    template <class RandomAccessIterator, class OutputIterator>
+    OutputIterator find_batch(RandomAccessIterator keys, size_type n, OutputIterator out) const
+    {
+        return t.find_batch(keys, n, out);
+    }
+    //б浽ļʹO(n)ؽҪmy_stl_serialize.hrb_treesave_binaryload_binary
+    friend bool save_binary(const char* path, const my_multimap& x)
+    {
+        return save_binary(path, x.t);
+    }
+    friend bool load_binary(const char* path, my_multimap& x)
+    {
+        return load_binary(path, x.t, false);
+    }
 };
+
+template <class Key, class T, class Compare, class Alloc>
+inline bool operator==(const my_multimap<Key, T, Compare, Alloc>& x, const my_multimap<Key, T, Compare, Alloc>& y)
+{
+    return x.size() == y.size() && equal(x.begin(), x.end(), y.begin());
+}
+
+template <class Key, class T, class Compare, class Alloc>
+inline bool operator<(const my_multimap<Key, T, Compare, Alloc>& x, const my_multimap<Key, T, Compare, Alloc>& y)
+{
+    return lexicographical_compare(x.begin(), x.end(), y.begin(), y.end());
+}
 #endif //__MY_STL_MAP_H
\ No newline at end of file
@@ -0,0 +1,101 @@
+#ifndef __MY_STL_OS_TREE_H
+#define __MY_STL_OS_TREE_H
+#include "my_stl_tree.h"
+
+//˳ͳÿڵ¼ΪĽڵ
+//תͲɾ·__rb_tree_size_updateάselectrankֻӸ½һ
+
+template <class Value>
+struct __rb_tree_os_node : public __rb_tree_node<Value>
+{
+    size_t subtree_size;    //ڵԼ
+};
+
+template <class Value>
+struct __rb_tree_size_update
+{
+    typedef __rb_tree_os_node<Value> node_type;
+    enum { enabled = 1 };
+
+    static size_t size(__rb_tree_node_base* x)
+    {
+        return x == 0 ? 0 : ((node_type*)x)->subtree_size;
+    }
+
+    void operator()(__rb_tree_node_base* x) const
+    {
+        ((node_type*)x)->subtree_size = 1 + size(x->left) + size(x->right);
+    }
+};
+
+template <class Key, class Value, class KeyOfValue, class Compare, class Alloc = my_alloc>
+class os_rb_tree : public rb_tree<Key, Value, KeyOfValue, Compare, Alloc, __rb_tree_size_update<Value> >
+{
+protected:
+    typedef rb_tree<Key, Value, KeyOfValue, Compare, Alloc, __rb_tree_size_update<Value> > base_type;
+    typedef __rb_tree_size_update<Value> size_update;
+    typedef typename base_type::link_type link_type;
+
+public:
+    typedef typename base_type::iterator iterator;
+    typedef typename base_type::const_iterator const_iterator;
+    typedef typename base_type::size_type size_type;
+
+    os_rb_tree(const Compare& comp = Compare()) : base_type(comp) {}
+
+    //kС0ʼĽڵ㣬kΧʱend()
+    iterator select(size_type k)
+    {
+        return iterator(__select(k));
+    }
+    const_iterator select(size_type k) const
+    {
+        return const_iterator(__select(k));
+    }
+
+    //ϸСkļֵ
+    size_type rank(const Key& k) const
+    {
+        size_type r = 0;
+        link_type x = this->root();
+        while (x != 0)
+        {
+            if (this->key_compare(base_type::key(x), k))
+            {
+                //xkС
+                r += size_update::size(x->left) + 1;
+                x = base_type::right(x);
+            }
+            else
+            {
+                x = base_type::left(x);
+            }
+        }
+        return r;
+    }
+
+protected:
+    link_type __select(size_type k) const
+    {
+        link_type x = this->root();
+        while (x != 0)
+        {
+            size_type left_size = size_update::size(x->left);
+            if (k < left_size)
+            {
+                x = base_type::left(x);
+            }
+            else if (k == left_size)
+            {
+                return x;
+            }
+            else
+            {
+                k -= left_size + 1;
+                x = base_type::right(x);
+            }
+        }
+        return this->header;
+    }
+};
+#endif //__MY_STL_OS_TREE_H
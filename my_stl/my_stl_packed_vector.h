@@ -0,0 +1,257 @@
+#ifndef __MY_STL_PACKED_VECTOR_H
+#define __MY_STL_PACKED_VECTOR_H
+#include <cstring>
+#include <stdint.h>
+#include "my_stl_alloc.h"
+#include "my_stl_vector.h"
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+using namespace std;
+
+//λѹvectorÿԪֻռwidthλ(1~32)ԪβӵشһֽУС
+//BitsΪ0ʱλڱȷɹ캯ָ
+//洢βһ֣κԪضһ8ֽڵķǶȡȡ
+template <size_t Bits = 0, class Alloc = my_alloc>
+class my_packed_vector
+{
+public:
+    typedef uint32_t value_type;
+    typedef size_t size_type;
+    typedef ptrdiff_t difference_type;
+
+    static_assert(Bits <= 32, "bit width must be at most 32");
+
+protected:
+    typedef simple_alloc<uint64_t, Alloc> data_allocator;
+
+    uint64_t* words;        //ѹ
+    size_type word_count;   //wordsĳȣβһ
+    size_type count;        //Ԫظ
+    size_type cap;          //·ʱܷŵԪظ
+    size_type bits;         //λBitsΪ0ʱBits
+
+    static uint64_t load64(const unsigned char* p)
+    {
+        uint64_t v;
+        memcpy(&v, p, sizeof(v));
+        return v;
+    }
+    static void store64(unsigned char* p, uint64_t v)
+    {
+        memcpy(p, &v, sizeof(v));
+    }
+
+    const unsigned char* bytes() const
+    {
+        return (const unsigned char*)words;
+    }
+    unsigned char* bytes()
+    {
+        return (unsigned char*)words;
+    }
+
+    //nԪҪһֱ֤8ֽڶȡԽ
+    size_type words_for(size_type n) const
+    {
+        return (n * width() + 63) / 64 + 1;
+    }
+
+    void reallocate(size_type new_cap)
+    {
+        size_type new_word_count = words_for(new_cap);
+        uint64_t* new_words = data_allocator::allocate(new_word_count);
+        memset(new_words, 0, new_word_count * sizeof(uint64_t));
+        if (words)
+        {
+            memcpy(new_words, words, (count * width() + 7) / 8);
+            data_allocator::deallocate(words, word_count);
+        }
+        words = new_words;
+        word_count = new_word_count;
+        cap = new_cap;
+    }
+
+    void unpack_scalar(size_type first, size_type n, value_type* out) const
+    {
+        const unsigned char* p = bytes();
+        const size_type w = width();
+        const uint64_t m = mask();
+        size_type bit = first * w;
+        for (size_type i = 0; i < n; ++i, bit += w)
+        {
+            out[i] = (value_type)((load64(p + (bit >> 3)) >> (bit & 7)) & m);
+        }
+    }
+
+public:
+    //캯
+    explicit my_packed_vector(size_type width_bits = Bits)
+        : words(0), word_count(0), count(0), cap(0), bits(Bits != 0 ? Bits : width_bits)
+    {
+        if (bits == 0 || bits > 32)
+        {
+            std::cerr << "invalid bit width" << std::endl;
+            exit(1);
+        }
+        reallocate(0);
+    }
+    my_packed_vector(size_type n, value_type value, size_type width_bits = Bits)
+        : words(0), word_count(0), count(0), cap(0), bits(Bits != 0 ? Bits : width_bits)
+    {
+        if (bits == 0 || bits > 32)
+        {
+            std::cerr << "invalid bit width" << std::endl;
+            exit(1);
+        }
+        reallocate(n);
+        for (size_type i = 0; i < n; ++i)
+        {
+            set(i, value);
+        }
+        count = n;
+    }
+
+    //
+    ~my_packed_vector()
+    {
+        data_allocator::deallocate(words, word_count);
+    }
+
+    my_packed_vector(const my_packed_vector&) = delete;
+    my_packed_vector& operator=(const my_packed_vector&) = delete;
+
+    size_type width() const
+    {
+        return Bits != 0 ? Bits : bits;
+    }
+    uint64_t mask() const
+    {
+        return (uint64_t(1) << width()) - 1;
+    }
+    size_type size() const
+    {
+        return count;
+    }
+    size_type capacity() const
+    {
+        return cap;
+    }
+    bool empty() const
+    {
+        return count == 0;
+    }
+    //ʵռõֽ
+    size_type memory_bytes() const
+    {
+        return word_count * sizeof(uint64_t);
+    }
+
+    value_type get(size_type i) const
+    {
+        size_type bit = i * width();
+        return (value_type)((load64(bytes() + (bit >> 3)) >> (bit & 7)) & mask());
+    }
+    value_type operator[](size_type i) const
+    {
+        return get(i);
+    }
+
+    //λĸλᱻص
+    void set(size_type i, value_type v)
+    {
+        size_type bit = i * width();
+        unsigned char* p = bytes() + (bit >> 3);
+        size_type shift = bit & 7;
+        uint64_t x = load64(p);
+        x &= ~(mask() << shift);
+        x |= ((uint64_t)v & mask()) << shift;
+        store64(p, x);
+    }
+
+    void push_back(value_type v)
+    {
+        if (count == cap)
+        {
+            reallocate(cap != 0 ? 2 * cap : 64);
+        }
+        set(count, v);
+        ++count;
+    }
+    void pop_back()
+    {
+        --count;
+    }
+    void reserve(size_type n)
+    {
+        if (n > cap)
+        {
+            reallocate(n);
+        }
+    }
+    void resize(size_type n, value_type v = 0)
+    {
+        reserve(n);
+        for (size_type i = count; i < n; ++i)
+        {
+            set(i, v);
+        }
+        count = n;
+    }
+    void clear()
+    {
+        count = 0;
+    }
+
+    //ѹ[first, first + n)out
+    //8Ԫǡռwidthֽڣ8ķڸԪصֽƫƺλǹ̶ģ
+    //֧AVX2ʱÿֻһgatherһλһ
+    void unpack(size_type first, size_type n, value_type* out) const
+    {
+#ifdef __AVX2__
+        const size_type w = width();
+        if (w <= 25)
+        {
+            //ñ8λ
+            size_type head = (8 - (first & 7)) & 7;
+            if (head > n)
+            {
+                head = n;
+            }
+            unpack_scalar(first, head, out);
+            first += head;
+            out += head;
+            n -= head;
+
+            //ÿlaneڷڵλƫΪlane*w7+2532һ32λȡ͹
+            const __m256i lane_bits = _mm256_mullo_epi32(_mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7),
+                _mm256_set1_epi32((int)w));
+            const __m256i offsets = _mm256_srli_epi32(lane_bits, 3);
+            const __m256i shifts = _mm256_and_si256(lane_bits, _mm256_set1_epi32(7));
+            const __m256i m = _mm256_set1_epi32((int)mask());
+            const unsigned char* p = bytes() + first * w / 8;
+            size_type i = 0;
+            for (; i + 8 <= n; i += 8, p += w)
+            {
+                __m256i v = _mm256_i32gather_epi32((const int*)p, offsets, 1);
+                v = _mm256_and_si256(_mm256_srlv_epi32(v, shifts), m);
+                _mm256_storeu_si256((__m256i*)(out + i), v);
+            }
+            unpack_scalar(first + i, n - i, out + i);
+            return;
+        }
+#endif
+        unpack_scalar(first, n, out);
+    }
+
+    //ѹȫԪصһmy_vector
+    void unpack(my_vector<value_type>& out) const
+    {
+        out.resize(count);
+        if (count != 0)
+        {
+            unpack(0, count, &out[0]);
+        }
+    }
+};
+#endif //__MY_STL_PACKED_VECTOR_H
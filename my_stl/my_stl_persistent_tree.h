@@ -0,0 +1,478 @@
+#ifndef __MY_STL_PERSISTENT_TREE_H
+#define __MY_STL_PERSISTENT_TREE_H
+#include <atomic>
+#include <iterator>
+#include "my_stl_alloc.h"
+#include "my_stl_construct.h"
+#include "my_stl_tree.h"
+using namespace std;
+
+//־ûһֻ汾ͬһO(1)֮ĲɾֻƴӸ޸ĵ·ϵĽڵ㣬
+//ڵɸ汾áڵûиָ루޷ãƽɾԶµݹ
+//ÿڵ¼ٸڵ汾ĸãΪ1Ľڵֻڵǰ汾ԭ޸ģ1ʱȸ޸
+//Ϊ0ʱͷŽڵ㣬Ծɰ汾ǰһֱɶ˭˭ͷ
+//̰߳ȫһ汾ͬһʱֻһ߳ʹã̸ͬ߳Գеİ汾ͬʱдýڵüԭӵ
+//Ĭʹõһ汾ڱ߳ڵǸ߳ͷ
+
+template <class Value>
+struct __persistent_rb_node
+{
+    typedef __persistent_rb_node<Value>* link_type;
+
+    link_type left;
+    link_type right;
+    atomic<size_t> refs;    //ڵĸڵͰ汾
+    __rb_tree_color_type color;
+    Value value_field;
+};
+
+//ĸ߶Ȳ2log2(n + 1)ڵַܵռƣ96㹻
+enum { __persistent_rb_max_height = 96 };
+
+//ûиָ룬ջ¼ûʵȣջΪǰڵ㣻ֻǰջʱΪend()
+template <class Value>
+struct __persistent_rb_iterator
+{
+    typedef forward_iterator_tag iterator_category;
+    typedef Value value_type;
+    typedef const Value& reference;
+    typedef const Value* pointer;
+    typedef ptrdiff_t difference_type;
+    typedef const __persistent_rb_node<Value>* link_type;
+    typedef __persistent_rb_iterator<Value> self;
+
+    link_type stack[__persistent_rb_max_height];
+    int depth;
+
+    __persistent_rb_iterator() : depth(0) {}
+
+    //xʼ½;еĽڵ㶼x֮󱻷
+    void push_left(link_type x)
+    {
+        for (; x != 0; x = x->left)
+        {
+            stack[depth++] = x;
+        }
+    }
+
+    reference operator*() const
+    {
+        return stack[depth - 1]->value_field;
+    }
+    pointer operator->() const
+    {
+        return &(operator*());
+    }
+    self& operator++()
+    {
+        link_type x = stack[--depth];
+        push_left(x->right);
+        return *this;
+    }
+    self operator++(int)
+    {
+        self tmp = *this;
+        ++*this;
+        return tmp;
+    }
+    bool operator==(const self& x) const
+    {
+        return depth == x.depth && (depth == 0 || stack[depth - 1] == x.stack[x.depth - 1]);
+    }
+    bool operator!=(const self& x) const
+    {
+        return !(*this == x);
+    }
+};
+
+template <class Key, class Value, class KeyOfValue, class Compare, class Alloc = malloc_alloc>
+class persistent_rb_tree
+{
+protected:
+    typedef __persistent_rb_node<Value> node;
+    typedef simple_alloc<node, Alloc> node_allocator;
+    typedef node* link_type;
+
+public:
+    typedef Key key_type;
+    typedef Value value_type;
+    typedef const value_type& const_reference;
+    typedef size_t size_type;
+    typedef ptrdiff_t difference_type;
+    typedef __persistent_rb_iterator<Value> const_iterator;
+    typedef const_iterator iterator;    //ڵܱ汾ãͨ޸
+
+protected:
+    link_type root;
+    size_type node_count;
+    Compare key_compare;
+
+    static const Key& key(const node* x)
+    {
+        return KeyOfValue()(x->value_field);
+    }
+    static bool is_red(const node* x)
+    {
+        return x != 0 && x->color == __rb_tree_red;
+    }
+
+    static link_type create_node(const value_type& v, __rb_tree_color_type color, link_type left, link_type right)
+    {
+        link_type tmp = node_allocator::allocate();
+        try
+        {
+            construct(&tmp->value_field, v);
+        }
+        catch (...)
+        {
+            node_allocator::deallocate(tmp);
+            exit(1);
+        }
+        construct(&tmp->refs, size_t(1));
+        tmp->color = color;
+        tmp->left = left;
+        tmp->right = right;
+        return tmp;
+    }
+    static void acquire(link_type x)
+    {
+        if (x != 0)
+        {
+            x->refs.fetch_add(1, memory_order_relaxed);
+        }
+    }
+    //xһãһʧʱͷxӽڵ
+    static void release(link_type x)
+    {
+        while (x != 0 && x->refs.fetch_sub(1, memory_order_acq_rel) == 1)
+        {
+            release(x->left);
+            link_type next = x->right;
+            ::destroy(&x->value_field);
+            node_allocator::deallocate(x);
+            x = next;
+        }
+    }
+    //֤slotָĽڵֻڵǰ汾һ滻֤߱slotڵĽڵѾֻڵǰ汾
+    static link_type own(link_type& slot)
+    {
+        link_type x = slot;
+        if (x->refs.load(memory_order_acquire) != 1)
+        {
+            acquire(x->left);
+            acquire(x->right);
+            slot = create_node(x->value_field, x->color, x->left, x->right);
+            release(x);
+        }
+        return slot;
+    }
+
+    //µҪhѾֻڵǰ汾ᱻĶӽڵown
+    static link_type rotate_left(link_type h)
+    {
+        link_type x = own(h->right);
+        h->right = x->left;
+        x->left = h;
+        x->color = h->color;
+        h->color = __rb_tree_red;
+        return x;
+    }
+    static link_type rotate_right(link_type h)
+    {
+        link_type x = own(h->left);
+        h->left = x->right;
+        x->right = h;
+        x->color = h->color;
+        h->color = __rb_tree_red;
+        return x;
+    }
+    static void flip_colors(link_type h)
+    {
+        link_type l = own(h->left);
+        link_type r = own(h->right);
+        l->color = !l->color;
+        r->color = !r->color;
+        h->color = !h->color;
+    }
+    //hh->leftǺɫhhֵܵĺɫߣʹɾԼ½
+    static link_type move_red_left(link_type h)
+    {
+        flip_colors(h);
+        if (is_red(h->right->left))
+        {
+            h->right = rotate_right(h->right);
+            h = rotate_left(h);
+            flip_colors(h);
+        }
+        return h;
+    }
+    static link_type move_red_right(link_type h)
+    {
+        flip_colors(h);
+        if (is_red(h->left->left))
+        {
+            h = rotate_right(h);
+            flip_colors(h);
+        }
+        return h;
+    }
+    //ʱָʣֻߣ߶ͷ
+    static link_type balance(link_type h)
+    {
+        if (is_red(h->right) && !is_red(h->left))
+        {
+            h = rotate_left(h);
+        }
+        if (is_red(h->left) && is_red(h->left->left))
+        {
+            h = rotate_right(h);
+        }
+        if (is_red(h->left) && is_red(h->right))
+        {
+            flip_colors(h);
+        }
+        return h;
+    }
+
+    link_type __insert(link_type h, const value_type& v);
+    link_type __erase(link_type h, const Key& k);
+    link_type __erase_min(link_type h);
+    const node* __lower_bound(const Key& k, const_iterator& it) const;
+
+public:
+    persistent_rb_tree(const Compare& comp = Compare()) : root(0), node_count(0), key_compare(comp) {}
+
+    //xȫڵ㣬O(1)
+    persistent_rb_tree(const persistent_rb_tree& x) : root(x.root), node_count(x.node_count), key_compare(x.key_compare)
+    {
+        acquire(root);
+    }
+    persistent_rb_tree& operator=(const persistent_rb_tree& x)
+    {
+        acquire(x.root);
+        release(root);
+        root = x.root;
+        node_count = x.node_count;
+        key_compare = x.key_compare;
+        return *this;
+    }
+    ~persistent_rb_tree()
+    {
+        release(root);
+    }
+
+    //ǰ汾ĿգO(1)֮*this޸ĲӰգտԽ̶߳
+    persistent_rb_tree snapshot() const
+    {
+        return *this;
+    }
+
+    Compare key_comp() const
+    {
+        return key_compare;
+    }
+    size_type size() const
+    {
+        return node_count;
+    }
+    bool empty() const
+    {
+        return node_count == 0;
+    }
+    void clear()
+    {
+        release(root);
+        root = 0;
+        node_count = 0;
+    }
+
+    const_iterator begin() const
+    {
+        const_iterator it;
+        it.push_left(root);
+        return it;
+    }
+    const_iterator end() const
+    {
+        return const_iterator();
+    }
+    const_iterator lower_bound(const Key& k) const
+    {
+        const_iterator it;
+        __lower_bound(k, it);
+        return it;
+    }
+    const_iterator find(const Key& k) const
+    {
+        const_iterator it;
+        const node* x = __lower_bound(k, it);
+        return (x == 0 || key_compare(k, key(x))) ? end() : it;
+    }
+    size_type count(const Key& k) const
+    {
+        size_type n = 0;
+        for (const_iterator it = lower_bound(k); it != end() && !key_compare(k, KeyOfValue()(*it)); ++it)
+        {
+            ++n;
+        }
+        return n;
+    }
+
+    //Ѵʱ룬Ƿ룻·ϵO(log n)ڵ
+    bool insert_unique(const value_type& v)
+    {
+        if (find(KeyOfValue()(v)) != end())
+        {
+            return false;
+        }
+        insert_equal(v);
+        return true;
+    }
+    void insert_equal(const value_type& v)
+    {
+        root = __insert(root, v);
+        root->color = __rb_tree_black;
+        ++node_count;
+    }
+    //ɾмΪkֵɾĸ
+    size_type erase(const Key& k);
+};
+
+//뵽hΪµĸȵļұ
+template <class Key, class Value, class KeyOfValue, class Compare, class Alloc>
+typename persistent_rb_tree<Key, Value, KeyOfValue, Compare, Alloc>::link_type
+persistent_rb_tree<Key, Value, KeyOfValue, Compare, Alloc>::__insert(link_type h, const value_type& v)
+{
+    if (h == 0)
+    {
+        return create_node(v, __rb_tree_red, 0, 0);
+    }
+    own(h);
+    if (key_compare(KeyOfValue()(v), key(h)))
+    {
+        h->left = __insert(h->left, v);
+    }
+    else
+    {
+        h->right = __insert(h->right, v);
+    }
+    return balance(h);
+}
+
+//hΪɾһΪkֵ֤߱khh->leftΪɫ
+template <class Key, class Value, class KeyOfValue, class Compare, class Alloc>
+typename persistent_rb_tree<Key, Value, KeyOfValue, Compare, Alloc>::link_type
+persistent_rb_tree<Key, Value, KeyOfValue, Compare, Alloc>::__erase(link_type h, const Key& k)
+{
+    own(h);
+    if (key_compare(k, key(h)))
+    {
+        if (!is_red(h->left) && !is_red(h->left->left))
+        {
+            h = move_red_left(h);
+        }
+        h->left = __erase(h->left, k);
+    }
+    else
+    {
+        if (is_red(h->left))
+        {
+            h = rotate_right(h);
+        }
+        if (!key_compare(key(h), k) && h->right == 0)
+        {
+            //hߴʱһΪ
+            release(h);
+            return 0;
+        }
+        //move_red_rightתʱԭhұߣµhkȵظұ߲__erase_minҪ
+        //ֻҪתͼɾԭh
+        link_type y = h;
+        if (!is_red(h->right) && !is_red(h->right->left))
+        {
+            h = move_red_right(h);
+        }
+        if (h == y && !key_compare(key(h), k))
+        {
+            //СֵhֵɾǸСֵ
+            link_type x = h->right;
+            while (x->left != 0)
+            {
+                x = x->left;
+            }
+            ::destroy(&h->value_field);
+            construct(&h->value_field, x->value_field);
+            h->right = __erase_min(h->right);
+        }
+        else
+        {
+            h->right = __erase(h->right, k);
+        }
+    }
+    return balance(h);
+}
+
+template <class Key, class Value, class KeyOfValue, class Compare, class Alloc>
+typename persistent_rb_tree<Key, Value, KeyOfValue, Compare, Alloc>::link_type
+persistent_rb_tree<Key, Value, KeyOfValue, Compare, Alloc>::__erase_min(link_type h)
+{
+    own(h);
+    if (h->left == 0)
+    {
+        release(h);
+        return 0;
+    }
+    if (!is_red(h->left) && !is_red(h->left->left))
+    {
+        h = move_red_left(h);
+    }
+    h->left = __erase_min(h->left);
+    return balance(h);
+}
+
+//صһСkĽڵ㣬itջͣڵϣʱ0itΪend()
+template <class Key, class Value, class KeyOfValue, class Compare, class Alloc>
+const typename persistent_rb_tree<Key, Value, KeyOfValue, Compare, Alloc>::node*
+persistent_rb_tree<Key, Value, KeyOfValue, Compare, Alloc>::__lower_bound(const Key& k, const_iterator& it) const
+{
+    const node* y = 0;
+    const node* x = root;
+    while (x != 0)
+    {
+        if (!key_compare(key(x), k))
+        {
+            //xڽ֮߾ǽ֮ǰջ
+            it.stack[it.depth++] = x;
+            y = x;
+            x = x->left;
+        }
+        else
+        {
+            x = x->right;
+        }
+    }
+    return y;
+}
+
+template <class Key, class Value, class KeyOfValue, class Compare, class Alloc>
+typename persistent_rb_tree<Key, Value, KeyOfValue, Compare, Alloc>::size_type
+persistent_rb_tree<Key, Value, KeyOfValue, Compare, Alloc>::erase(const Key& k)
+{
+    size_type n = 0;
+    while (find(k) != end())
+    {
+        if (!is_red(root->left) && !is_red(root->right))
+        {
+            own(root)->color = __rb_tree_red;
+        }
+        root = __erase(root, k);
+        if (root != 0)
+        {
+            root->color = __rb_tree_black;
+        }
+        --node_count;
+        ++n;
+    }
+    return n;
+}
+#endif //__MY_STL_PERSISTENT_TREE_H
@@ -0,0 +1,425 @@
+#ifndef __MY_STL_SEGMENTED_VECTOR_H
+#define __MY_STL_SEGMENTED_VECTOR_H
+#include <iterator>
+#include <memory>
+#include "my_stl_alloc.h"
+#include "my_stl_construct.h"
+using namespace std;
+
+//ֶvectorԪشڹ̶СĿУһ(map)dequeֻβ
+//ʱֻҪ·ָ룩ԪشӲƣԪصַȶ
+
+//С2ݣoperator[]ֻҪλ
+constexpr size_t __segmented_vector_floor_pow2(size_t n)
+{
+    return n <= 1 ? 1 : 2 * __segmented_vector_floor_pow2(n / 2);
+}
+
+constexpr size_t __segmented_vector_log2(size_t n)
+{
+    return n <= 1 ? 0 : 1 + __segmented_vector_log2(n / 2);
+}
+
+//nΪ0ʱûָÿԪظÿԼ4096ֽ
+constexpr size_t __segmented_vector_buf_size(size_t n, size_t sz)
+{
+    return n != 0 ? n : (sz < 4096 ? __segmented_vector_floor_pow2(4096 / sz) : 1);
+}
+
+template <class T, class Ref, class Ptr, size_t BufSiz>
+struct __segmented_vector_iterator
+{
+    typedef __segmented_vector_iterator<T, T&, T*, BufSiz> iterator;
+    typedef __segmented_vector_iterator<T, const T&, const T*, BufSiz> const_iterator;
+    static size_t buffer_size()
+    {
+        return __segmented_vector_buf_size(BufSiz, sizeof(T));
+    }
+
+    typedef random_access_iterator_tag iterator_category;
+    typedef T value_type;
+    typedef Ptr pointer;
+    typedef Ref reference;
+    typedef size_t size_type;
+    typedef ptrdiff_t difference_type;
+    typedef T** map_pointer;
+    typedef __segmented_vector_iterator self;
+
+    T* cur;     //ǰԪ
+    T* first;   //ǰͷ
+    T* last;    //ǰβ
+    map_pointer node;   //ָеĵǰ
+
+    __segmented_vector_iterator() : cur(0), first(0), last(0), node(0) {}
+    __segmented_vector_iterator(const iterator& x)
+        : cur(x.cur), first(x.first), last(x.last), node(x.node) {}
+    //iteratorʵĹ캯ǿ죬Ҫʽֵ
+    self& operator=(const self&) = default;
+
+    //һ
+    void set_node(map_pointer new_node)
+    {
+        node = new_node;
+        first = *new_node;
+        last = first + difference_type(buffer_size());
+    }
+
+    reference operator*() const
+    {
+        return *cur;
+    }
+    pointer operator->() const
+    {
+        return &(operator*());
+    }
+
+    difference_type operator-(const self& x) const
+    {
+        return difference_type(buffer_size()) * (node - x.node - 1) +
+            (cur - first) + (x.last - x.cur);
+    }
+
+    self& operator++()
+    {
+        ++cur;
+        if (cur == last)
+        {
+            set_node(node + 1);
+            cur = first;
+        }
+        return *this;
+    }
+    self operator++(int)
+    {
+        self tmp = *this;
+        ++*this;
+        return tmp;
+    }
+
+    self& operator--()
+    {
+        if (cur == first)
+        {
+            set_node(node - 1);
+            cur = last;
+        }
+        --cur;
+        return *this;
+    }
+    self operator--(int)
+    {
+        self tmp = *this;
+        --*this;
+        return tmp;
+    }
+
+    self& operator+=(difference_type n)
+    {
+        difference_type offset = n + (cur - first);
+        if (offset >= 0 && offset < difference_type(buffer_size()))
+        {
+            //ͬһ
+            cur += n;
+        }
+        else
+        {
+            difference_type node_offset = offset > 0 ?
+                offset / difference_type(buffer_size()) :
+                -difference_type((-offset - 1) / buffer_size()) - 1;
+            set_node(node + node_offset);
+            cur = first + (offset - node_offset * difference_type(buffer_size()));
+        }
+        return *this;
+    }
+    self operator+(difference_type n) const
+    {
+        self tmp = *this;
+        return tmp += n;
+    }
+    self& operator-=(difference_type n)
+    {
+        return *this += -n;
+    }
+    self operator-(difference_type n) const
+    {
+        self tmp = *this;
+        return tmp -= n;
+    }
+
+    reference operator[](difference_type n) const
+    {
+        return *(*this + n);
+    }
+
+    bool operator==(const self& x) const
+    {
+        return cur == x.cur;
+    }
+    bool operator!=(const self& x) const
+    {
+        return !(*this == x);
+    }
+    bool operator<(const self& x) const
+    {
+        return (node == x.node) ? (cur < x.cur) : (node < x.node);
+    }
+};
+
+template <class T, class Alloc = my_alloc, size_t BufSiz = 0>
+class my_segmented_vector
+{
+public:
+    typedef T value_type;
+    typedef value_type* pointer;
+    typedef const value_type* const_pointer;
+    typedef value_type& reference;
+    typedef const value_type& const_reference;
+    typedef size_t size_type;
+    typedef ptrdiff_t difference_type;
+    typedef __segmented_vector_iterator<T, T&, T*, BufSiz> iterator;
+    typedef __segmented_vector_iterator<T, const T&, const T*, BufSiz> const_iterator;
+
+    enum { block_size = __segmented_vector_buf_size(BufSiz, sizeof(T)) };
+    static_assert((block_size & (block_size - 1)) == 0, "block size must be a power of two");
+
+protected:
+    typedef pointer* map_pointer;
+    typedef simple_alloc<value_type, Alloc> data_allocator;
+    typedef simple_alloc<pointer, Alloc> map_allocator;
+    enum { block_shift = __segmented_vector_log2(block_size) };
+    enum { initial_map_size = 8 };
+
+    iterator start;     //һԪأʼλmap[0]ͷ
+    iterator finish;    //һԪصһλãڿѾõ
+    map_pointer map;    //ÿԪָһ
+    size_type map_size; //
+
+    pointer allocate_node()
+    {
+        return data_allocator::allocate(block_size);
+    }
+    void deallocate_node(pointer p)
+    {
+        data_allocator::deallocate(p, block_size);
+    }
+
+    void create_map_and_nodes(size_type num_elements);
+    void reallocate_map();
+    void push_back_aux(const value_type& x);
+
+    void fill_initialize(size_type n, const value_type& value)
+    {
+        create_map_and_nodes(n);
+        iterator cur = start;
+        try
+        {
+            for (; cur != finish; ++cur)
+            {
+                construct(&*cur, value);
+            }
+        }
+        catch (...)
+        {
+            ::destroy(start, cur);
+            destroy_map_and_nodes();
+            throw;
+        }
+    }
+
+    void destroy_map_and_nodes()
+    {
+        for (map_pointer n = start.node; n <= finish.node; ++n)
+        {
+            deallocate_node(*n);
+        }
+        map_allocator::deallocate(map, map_size);
+    }
+
+public:
+    //캯
+    my_segmented_vector() : map(0), map_size(0)
+    {
+        create_map_and_nodes(0);
+    }
+    my_segmented_vector(size_type n, const T& value) : map(0), map_size(0)
+    {
+        fill_initialize(n, value);
+    }
+    explicit my_segmented_vector(size_type n) : map(0), map_size(0)
+    {
+        fill_initialize(n, T());
+    }
+
+    //
+    ~my_segmented_vector()
+    {
+        ::destroy(start, finish);
+        destroy_map_and_nodes();
+    }
+
+    my_segmented_vector(const my_segmented_vector&) = delete;
+    my_segmented_vector& operator=(const my_segmented_vector&) = delete;
+
+    iterator begin()
+    {
+        return start;
+    }
+    iterator end()
+    {
+        return finish;
+    }
+    const_iterator begin() const
+    {
+        return start;
+    }
+    const_iterator end() const
+    {
+        return finish;
+    }
+    size_type size() const
+    {
+        return finish - start;
+    }
+    bool empty() const
+    {
+        return finish == start;
+    }
+
+    //startmap[0]ͷʲҪ
+    reference operator[](size_type n)
+    {
+        return map[n >> block_shift][n & (block_size - 1)];
+    }
+    const_reference operator[](size_type n) const
+    {
+        return map[n >> block_shift][n & (block_size - 1)];
+    }
+
+    reference front()
+    {
+        return *start;
+    }
+    reference back()
+    {
+        iterator tmp = finish;
+        --tmp;
+        return *tmp;
+    }
+
+    void push_back(const T& x)
+    {
+        if (finish.cur != finish.last - 1)
+        {
+            //ǰ黹ϵĿλ
+            construct(finish.cur, x);
+            ++finish.cur;
+        }
+        else
+        {
+            push_back_aux(x);
+        }
+    }
+
+    void pop_back()
+    {
+        if (finish.cur != finish.first)
+        {
+            --finish.cur;
+            ::destroy(finish.cur);
+        }
+        else
+        {
+            //һǿյģͷ˻һ
+            deallocate_node(finish.first);
+            finish.set_node(finish.node - 1);
+            finish.cur = finish.last - 1;
+            ::destroy(finish.cur);
+        }
+    }
+
+    //ֻһ飬С
+    void clear()
+    {
+        ::destroy(start, finish);
+        for (map_pointer n = start.node + 1; n <= finish.node; ++n)
+        {
+            deallocate_node(*n);
+        }
+        finish = start;
+    }
+};
+
+template <class T, class Alloc, size_t BufSiz>
+void my_segmented_vector<T, Alloc, BufSiz>::create_map_and_nodes(size_type num_elements)
+{
+    //ҪĿΪԪظԿСټһfinishڵĿǴ
+    size_type num_nodes = (num_elements >> block_shift) + 1;
+
+    map_size = num_nodes + 1 > size_type(initial_map_size) ? num_nodes + 1 : size_type(initial_map_size);
+    map = map_allocator::allocate(map_size);
+
+    map_pointer cur = map;
+    try
+    {
+        for (; cur < map + num_nodes; ++cur)
+        {
+            *cur = allocate_node();
+        }
+    }
+    catch (...)
+    {
+        //commit or rollback
+        for (map_pointer n = map; n < cur; ++n)
+        {
+            deallocate_node(*n);
+        }
+        map_allocator::deallocate(map, map_size);
+        throw;
+    }
+
+    start.set_node(map);
+    finish.set_node(map + num_nodes - 1);
+    start.cur = start.first;
+    finish.cur = finish.first + (num_elements & (block_size - 1));
+}
+
+//ˣֻѿָ뿽УԪر
+template <class T, class Alloc, size_t BufSiz>
+void my_segmented_vector<T, Alloc, BufSiz>::reallocate_map()
+{
+    size_type old_num_nodes = finish.node - start.node + 1;
+    size_type new_map_size = map_size * 2;
+
+    map_pointer new_map = map_allocator::allocate(new_map_size);
+    copy(start.node, finish.node + 1, new_map);
+    map_allocator::deallocate(map, map_size);
+
+    map = new_map;
+    map_size = new_map_size;
+    start.node = new_map;
+    finish.node = new_map + old_num_nodes - 1;
+}
+
+//ǰֻʣһλΪfinish׼һ
+template <class T, class Alloc, size_t BufSiz>
+void my_segmented_vector<T, Alloc, BufSiz>::push_back_aux(const value_type& x)
+{
+    if (size_type(finish.node - map) + 1 >= map_size)
+    {
+        reallocate_map();
+    }
+
+    *(finish.node + 1) = allocate_node();
+    try
+    {
+        construct(finish.cur, x);
+    }
+    catch (...)
+    {
+        deallocate_node(*(finish.node + 1));
+        throw;
+    }
+    finish.set_node(finish.node + 1);
+    finish.cur = finish.first;
+}
+#endif //__MY_STL_SEGMENTED_VECTOR_H
@@ -0,0 +1,373 @@
+#ifndef __MY_STL_SERIALIZE_H
+#define __MY_STL_SERIALIZE_H
+#include <cstdio>
+#include <cstring>
+#include <stdint.h>
+#include <type_traits>
+#include "my_stl_vector.h"
+#include "my_stl_tree.h"
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+using namespace std;
+
+//ļʽ64ֽڵļͷԪصԭʼֽ
+//ļͷ¼ħ汾ֽԪشСͶ롢ԪظԼУͣκһܾ
+//64ֽڴʼӳԪضֱӵʹ
+
+enum { __SERIALIZE_VERSION = 1 };
+enum { __SERIALIZE_HEADER_SIZE = 64 };
+enum { __SERIALIZE_VECTOR = 1, __SERIALIZE_SORTED_RUN = 2 };
+const uint32_t __SERIALIZE_BYTE_ORDER = 0x01020304;
+
+struct __serialize_header
+{
+    char magic[8];          //"MYSTLBIN"
+    uint32_t version;
+    uint32_t byte_order;    //ֽд0x01020304ز˵ֽͬ
+    uint32_t kind;          //vector
+    uint32_t value_size;    //sizeof(T)
+    uint32_t value_align;   //alignof(T)
+    uint32_t reserved;
+    uint64_t count;         //Ԫظ
+    uint64_t checksum;      //FNV-1aУ
+};
+
+//ֻֽڿܵõȼ۶Ͳ
+template <class T>
+struct __is_raw_serializable
+{
+    static const bool value = is_trivially_copy_constructible<T>::value &&
+        is_trivially_destructible<T>::value;
+};
+
+inline uint64_t __serialize_checksum(const void* data, size_t n, uint64_t h = 14695981039346656037ULL)
+{
+    const unsigned char* p = (const unsigned char*)data;
+    for (size_t i = 0; i < n; ++i)
+    {
+        h ^= p[i];
+        h *= 1099511628211ULL;
+    }
+    return h;
+}
+
+inline void __serialize_fill_header(__serialize_header& h, uint32_t kind, size_t value_size,
+    size_t value_align, uint64_t count, uint64_t checksum)
+{
+    memset(&h, 0, sizeof(h));
+    memcpy(h.magic, "MYSTLBIN", 8);
+    h.version = __SERIALIZE_VERSION;
+    h.byte_order = __SERIALIZE_BYTE_ORDER;
+    h.kind = kind;
+    h.value_size = (uint32_t)value_size;
+    h.value_align = (uint32_t)value_align;
+    h.count = count;
+    h.checksum = checksum;
+}
+
+//дļͷʱռλдٻݿԱ߱д
+inline bool __serialize_write_header(FILE* fp, const __serialize_header& h)
+{
+    char buf[__SERIALIZE_HEADER_SIZE];
+    memset(buf, 0, sizeof(buf));
+    memcpy(buf, &h, sizeof(h));
+    return fseek(fp, 0, SEEK_SET) == 0 && fwrite(buf, 1, sizeof(buf), fp) == sizeof(buf);
+}
+
+//ֻӳļ
+class __mapped_file
+{
+private:
+    const char* base;
+    size_t length;
+#ifdef _WIN32
+    HANDLE file;
+    HANDLE mapping;
+#endif
+
+public:
+    __mapped_file() : base(0), length(0)
+#ifdef _WIN32
+        , file(INVALID_HANDLE_VALUE), mapping(0)
+#endif
+    {}
+    ~__mapped_file()
+    {
+        close();
+    }
+
+    __mapped_file(const __mapped_file&) = delete;
+    __mapped_file& operator=(const __mapped_file&) = delete;
+
+    bool open(const char* path)
+    {
+        close();
+#ifdef _WIN32
+        file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, 0, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, 0);
+        if (file == INVALID_HANDLE_VALUE)
+        {
+            return false;
+        }
+        LARGE_INTEGER sz;
+        if (!GetFileSizeEx(file, &sz) || sz.QuadPart == 0)
+        {
+            close();
+            return false;
+        }
+        mapping = CreateFileMappingA(file, 0, PAGE_READONLY, 0, 0, 0);
+        if (mapping == 0)
+        {
+            close();
+            return false;
+        }
+        base = (const char*)MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        if (base == 0)
+        {
+            close();
+            return false;
+        }
+        length = (size_t)sz.QuadPart;
+#else
+        int fd = ::open(path, O_RDONLY);
+        if (fd < 0)
+        {
+            return false;
+        }
+        struct stat st;
+        if (fstat(fd, &st) != 0 || st.st_size == 0)
+        {
+            ::close(fd);
+            return false;
+        }
+        void* p = mmap(0, (size_t)st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+        ::close(fd);    //ӳ佨ļͲҪ
+        if (p == MAP_FAILED)
+        {
+            return false;
+        }
+        base = (const char*)p;
+        length = (size_t)st.st_size;
+#endif
+        return true;
+    }
+
+    void close()
+    {
+#ifdef _WIN32
+        if (base)
+        {
+            UnmapViewOfFile(base);
+        }
+        if (mapping)
+        {
+            CloseHandle(mapping);
+        }
+        if (file != INVALID_HANDLE_VALUE)
+        {
+            CloseHandle(file);
+        }
+        mapping = 0;
+        file = INVALID_HANDLE_VALUE;
+#else
+        if (base)
+        {
+            munmap((void*)base, length);
+        }
+#endif
+        base = 0;
+        length = 0;
+    }
+
+    const char* data() const
+    {
+        return base;
+    }
+    size_t size() const
+    {
+        return length;
+    }
+};
+
+//Уӳļļͷɹʱ
+template <class T>
+const T* __serialize_check(const __mapped_file& f, uint32_t kind, uint64_t& count)
+{
+    if (f.size() < (size_t)__SERIALIZE_HEADER_SIZE)
+    {
+        return 0;
+    }
+    __serialize_header h;
+    memcpy(&h, f.data(), sizeof(h));
+    if (memcmp(h.magic, "MYSTLBIN", 8) != 0 ||
+        h.version != __SERIALIZE_VERSION ||
+        h.byte_order != __SERIALIZE_BYTE_ORDER ||
+        h.kind != kind ||
+        h.value_size != sizeof(T) ||
+        h.value_align != alignof(T) ||
+        alignof(T) > (size_t)__SERIALIZE_HEADER_SIZE)
+    {
+        return 0;
+    }
+    size_t payload = f.size() - __SERIALIZE_HEADER_SIZE;
+    if (h.count > payload / sizeof(T) || h.count * sizeof(T) != payload)
+    {
+        return 0;
+    }
+    const char* data = f.data() + __SERIALIZE_HEADER_SIZE;
+    if (__serialize_checksum(data, payload) != h.checksum)
+    {
+        return 0;
+    }
+    count = h.count;
+    return (const T*)data;
+}
+
+//vectorԪͱֽڿ
+template <class T, class Alloc>
+bool save_binary(const char* path, const my_vector<T, Alloc>& v)
+{
+    static_assert(__is_raw_serializable<T>::value, "element type must be trivially copyable");
+
+    FILE* fp = fopen(path, "wb");
+    if (fp == 0)
+    {
+        return false;
+    }
+    size_t bytes = v.size() * sizeof(T);
+    __serialize_header h;
+    __serialize_fill_header(h, __SERIALIZE_VECTOR, sizeof(T), alignof(T), v.size(),
+        __serialize_checksum(v.begin(), bytes));
+    bool ok = __serialize_write_header(fp, h) && fwrite(v.begin(), 1, bytes, fp) == bytes;
+    return fclose(fp) == 0 && ok;
+}
+
+//еֵΪб棬my_mapmy_multimapmy_setmy_multisetͬԪת
+template <class Key, class Value, class KeyOfValue, class Compare, class Alloc, class NodeUpdate, class Stats>
+bool save_binary(const char* path, const rb_tree<Key, Value, KeyOfValue, Compare, Alloc, NodeUpdate, Stats>& t)
+{
+    static_assert(__is_raw_serializable<Value>::value, "value type must be trivially copyable");
+    typedef typename rb_tree<Key, Value, KeyOfValue, Compare, Alloc, NodeUpdate, Stats>::const_iterator const_iterator;
+
+    FILE* fp = fopen(path, "wb");
+    if (fp == 0)
+    {
+        return false;
+    }
+    char zeros[__SERIALIZE_HEADER_SIZE] = { 0 };
+    bool ok = fwrite(zeros, 1, sizeof(zeros), fp) == sizeof(zeros);
+
+    uint64_t checksum = __serialize_checksum(0, 0);
+    for (const_iterator it = t.begin(); ok && it != t.end(); ++it)
+    {
+        const Value& v = *it;
+        checksum = __serialize_checksum(&v, sizeof(Value), checksum);
+        ok = fwrite(&v, 1, sizeof(Value), fp) == sizeof(Value);
+    }
+
+    __serialize_header h;
+    __serialize_fill_header(h, __SERIALIZE_SORTED_RUN, sizeof(Value), alignof(Value), t.size(), checksum);
+    ok = ok && __serialize_write_header(fp, h);
+    return fclose(fp) == 0 && ok;
+}
+
+//ļO(n)ؽļƥʱfalseҲĶt
+//лҪtıȽ׼uniqueΪtrueظʱϸܵݼ
+//ñıȽ׼򱣴ļظļװ벻ظʱᱻܾ
+template <class Key, class Value, class KeyOfValue, class Compare, class Alloc, class NodeUpdate, class Stats>
+bool load_binary(const char* path, rb_tree<Key, Value, KeyOfValue, Compare, Alloc, NodeUpdate, Stats>& t, bool unique = true)
+{
+    static_assert(__is_raw_serializable<Value>::value, "value type must be trivially copyable");
+
+    __mapped_file f;
+    uint64_t count = 0;
+    const Value* data = f.open(path) ? __serialize_check<Value>(f, __SERIALIZE_SORTED_RUN, count) : 0;
+    if (data == 0)
+    {
+        return false;
+    }
+    Compare comp = t.key_comp();
+    KeyOfValue get_key;
+    for (size_t i = 1; i < (size_t)count; ++i)
+    {
+        const Key& prev = get_key(data[i - 1]);
+        const Key& cur = get_key(data[i]);
+        if (unique ? !comp(prev, cur) : comp(cur, prev))
+        {
+            return false;
+        }
+    }
+    t.assign_sorted(data, (size_t)count);
+    return true;
+}
+
+//㿽صvectorֱӰļӳΪֻ飬Ԫ
+template <class T>
+class my_mapped_vector
+{
+public:
+    typedef T value_type;
+    typedef const value_type* const_iterator;
+    typedef const value_type* iterator;
+    typedef const value_type& const_reference;
+    typedef size_t size_type;
+
+    static_assert(__is_raw_serializable<T>::value, "element type must be trivially copyable");
+
+private:
+    __mapped_file file;
+    const T* start;
+    size_type count;
+
+public:
+    my_mapped_vector() : start(0), count(0) {}
+
+    //ļƥʱfalse󱣳Ϊ
+    bool open(const char* path)
+    {
+        close();
+        uint64_t n = 0;
+        const T* data = file.open(path) ? __serialize_check<T>(file, __SERIALIZE_VECTOR, n) : 0;
+        if (data == 0)
+        {
+            file.close();
+            return false;
+        }
+        start = data;
+        count = (size_type)n;
+        return true;
+    }
+    void close()
+    {
+        file.close();
+        start = 0;
+        count = 0;
+    }
+
+    const_iterator begin() const
+    {
+        return start;
+    }
+    const_iterator end() const
+    {
+        return start + count;
+    }
+    size_type size() const
+    {
+        return count;
+    }
+    bool empty() const
+    {
+        return count == 0;
+    }
+    const_reference operator[](size_type n) const
+    {
+        return start[n];
+    }
+};
+#endif //__MY_STL_SERIALIZE_H
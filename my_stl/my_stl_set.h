@@ -0,0 +1,323 @@
+#ifndef __MY_STL_SET_H
+#define __MY_STL_SET_H
+#include <algorithm>
+#include <functional>
+#include <initializer_list>
+#include <utility>
+#include "my_stl_tree.h"
+#include "my_stl_frozen_tree.h"
+using namespace std;
+
+//ϵֵǼͨ޸ģiteratorconst_iteratorrb_treeconst_iterator
+template <class Key, class Compare = std::less<Key>, class Alloc = my_alloc>
+class my_set
+{
+public:
+    typedef Key key_type;
+    typedef Key value_type;
+    typedef Compare key_compare;
+    typedef Compare value_compare;
+
+private:
+    typedef rb_tree<key_type, value_type, my_identity<value_type>, key_compare, Alloc> rep_type;
+    typedef typename rep_type::iterator rep_iterator;
+    rep_type t;
+
+public:
+    typedef typename rep_type::const_pointer pointer;
+    typedef typename rep_type::const_pointer const_pointer;
+    typedef typename rep_type::const_reference reference;
+    typedef typename rep_type::const_reference const_reference;
+    typedef typename rep_type::const_iterator iterator;
+    typedef typename rep_type::const_iterator const_iterator;
+    typedef typename rep_type::const_reverse_iterator reverse_iterator;
+    typedef typename rep_type::const_reverse_iterator const_reverse_iterator;
+    typedef typename rep_type::size_type size_type;
+    typedef typename rep_type::difference_type difference_type;
+    typedef frozen_rb_tree<key_type, value_type, my_identity<value_type>, key_compare, Alloc> frozen_type;
+
+    my_set() : t(Compare()) {}
+    explicit my_set(const Compare& comp) : t(comp) {}
+    template <class InputIterator>
+    my_set(InputIterator first, InputIterator last, const Compare& comp = Compare()) : t(comp)
+    {
+        t.insert_unique(first, last);
+    }
+    my_set(initializer_list<value_type> l, const Compare& comp = Compare()) : t(comp)
+    {
+        t.insert_unique(l.begin(), l.end());
+    }
+
+    key_compare key_comp() const { return t.key_comp(); }
+    value_compare value_comp() const { return t.key_comp(); }
+    iterator begin() const { return t.begin(); }
+    iterator end() const { return t.end(); }
+    reverse_iterator rbegin() const { return t.rbegin(); }
+    reverse_iterator rend() const { return t.rend(); }
+    bool empty() const { return t.empty(); }
+    size_type size() const { return t.size(); }
+    size_type max_size() const { return t.max_size(); }
+
+    pair<iterator, bool> insert(const value_type& x)
+    {
+        pair<rep_iterator, bool> p = t.insert_unique(x);
+        return pair<iterator, bool>(p.first, p.second);
+    }
+    //Ȱx½ʱŰxƽ½ڵ
+    pair<iterator, bool> insert(value_type&& x)
+    {
+        pair<rep_iterator, bool> p = t.emplace_unique_key(x, std::move(x));
+        return pair<iterator, bool>(p.first, p.second);
+    }
+    iterator insert(iterator position, const value_type& x)
+    {
+        return t.insert_unique((rep_iterator&)position, x);
+    }
+    template <class InputIterator>
+    void insert(InputIterator first, InputIterator last)
+    {
+        t.insert_unique(first, last);
+    }
+    void insert(initializer_list<value_type> l)
+    {
+        t.insert_unique(l.begin(), l.end());
+    }
+    template <class... Args>
+    pair<iterator, bool> emplace(Args&&... args)
+    {
+        pair<rep_iterator, bool> p = t.emplace_unique(std::forward<Args>(args)...);
+        return pair<iterator, bool>(p.first, p.second);
+    }
+
+    void erase(iterator position) { t.erase((rep_iterator&)position); }
+    size_type erase(const key_type& x) { return t.erase(x); }
+    void erase(iterator first, iterator last) { t.erase((rep_iterator&)first, (rep_iterator&)last); }
+    void clear() { t.clear(); }
+
+    iterator find(const key_type& x) const { return t.find(x); }
+    size_type count(const key_type& x) const { return t.find(x) == t.end() ? 0 : 1; }
+    iterator lower_bound(const key_type& x) const { return t.lower_bound(x); }
+    iterator upper_bound(const key_type& x) const { return t.upper_bound(x); }
+    pair<iterator, iterator> equal_range(const key_type& x) const { return t.equal_range(x); }
+    //Ƚ׼is_transparentʱֱkey_typeȽϵͲ
+    template <class K, class C = Compare, class = typename C::is_transparent>
+    iterator find(const K& x) const { return t.find(x); }
+    template <class K, class C = Compare, class = typename C::is_transparent>
+    size_type count(const K& x) const { return t.find(x) == t.end() ? 0 : 1; }
+    template <class K, class C = Compare, class = typename C::is_transparent>
+    iterator lower_bound(const K& x) const { return t.lower_bound(x); }
+    template <class K, class C = Compare, class = typename C::is_transparent>
+    iterator upper_bound(const K& x) const { return t.upper_bound(x); }
+    template <class K, class C = Compare, class = typename C::is_transparent>
+    pair<iterator, iterator> equal_range(const K& x) const { return t.equal_range(x); }
+
+    //ֱӰƽڵ㣬rb_treeͬ
+    void split(const key_type& k, my_set& right) { t.split(k, right.t); }
+    void join(my_set& right) { t.join(right.t); }
+    void union_with(my_set& x) { t.union_with(x.t); }
+    void intersect_with(my_set& x) { t.intersect_with(x.t); }
+    void difference_with(my_set& x) { t.difference_with(x.t); }
+
+    frozen_type freeze() const
+    {
+        return t.freeze();
+    }
+    template <class OutputIterator>
+    OutputIterator split_range(size_type depth, OutputIterator out) const
+    {
+        return t.split_range(depth, out);
+    }
+    template <class Function>
+    void parallel_for_each(Function f) const
+    {
+        t.parallel_for_each(f);
+    }
+    template <class U, class Accumulate, class Combine>
+    U parallel_reduce(U identity, Accumulate acc, Combine combine) const
+    {
+        return t.parallel_reduce(identity, acc, combine);
+    }
+    template <class U, class BinaryOperation>
+    U parallel_reduce(U identity, BinaryOperation op) const
+    {
+        return t.parallel_reduce(identity, op);
+    }
+    template <class RandomAccessIterator, class OutputIterator>
+    OutputIterator find_batch(RandomAccessIterator keys, size_type n, OutputIterator out) const
+    {
+        return t.find_batch(keys, n, out);
+    }
+    //б浽ļʹO(n)ؽҪmy_stl_serialize.hrb_treesave_binaryload_binary
+    friend bool save_binary(const char* path, const my_set& x)
+    {
+        return save_binary(path, x.t);
+    }
+    friend bool load_binary(const char* path, my_set& x)
+    {
+        return load_binary(path, x.t, true);
+    }
+};
+
+template <class Key, class Compare, class Alloc>
+inline bool operator==(const my_set<Key, Compare, Alloc>& x, const my_set<Key, Compare, Alloc>& y)
+{
+    return x.size() == y.size() && equal(x.begin(), x.end(), y.begin());
+}
+
+template <class Key, class Compare, class Alloc>
+inline bool operator<(const my_set<Key, Compare, Alloc>& x, const my_set<Key, Compare, Alloc>& y)
+{
+    return lexicographical_compare(x.begin(), x.end(), y.begin(), y.end());
+}
+
+//ظļϣȵֵȺ
+template <class Key, class Compare = std::less<Key>, class Alloc = my_alloc>
+class my_multiset
+{
+public:
+    typedef Key key_type;
+    typedef Key value_type;
+    typedef Compare key_compare;
+    typedef Compare value_compare;
+
+private:
+    typedef rb_tree<key_type, value_type, my_identity<value_type>, key_compare, Alloc> rep_type;
+    typedef typename rep_type::iterator rep_iterator;
+    rep_type t;
+
+public:
+    typedef typename rep_type::const_pointer pointer;
+    typedef typename rep_type::const_pointer const_pointer;
+    typedef typename rep_type::const_reference reference;
+    typedef typename rep_type::const_reference const_reference;
+    typedef typename rep_type::const_iterator iterator;
+    typedef typename rep_type::const_iterator const_iterator;
+    typedef typename rep_type::const_reverse_iterator reverse_iterator;
+    typedef typename rep_type::const_reverse_iterator const_reverse_iterator;
+    typedef typename rep_type::size_type size_type;
+    typedef typename rep_type::difference_type difference_type;
+    typedef frozen_rb_tree<key_type, value_type, my_identity<value_type>, key_compare, Alloc> frozen_type;
+
+    my_multiset() : t(Compare()) {}
+    explicit my_multiset(const Compare& comp) : t(comp) {}
+    template <class InputIterator>
+    my_multiset(InputIterator first, InputIterator last, const Compare& comp = Compare()) : t(comp)
+    {
+        t.insert_equal(first, last);
+    }
+    my_multiset(initializer_list<value_type> l, const Compare& comp = Compare()) : t(comp)
+    {
+        t.insert_equal(l.begin(), l.end());
+    }
+
+    key_compare key_comp() const { return t.key_comp(); }
+    value_compare value_comp() const { return t.key_comp(); }
+    iterator begin() const { return t.begin(); }
+    iterator end() const { return t.end(); }
+    reverse_iterator rbegin() const { return t.rbegin(); }
+    reverse_iterator rend() const { return t.rend(); }
+    bool empty() const { return t.empty(); }
+    size_type size() const { return t.size(); }
+    size_type max_size() const { return t.max_size(); }
+
+    iterator insert(const value_type& x)
+    {
+        return t.insert_equal(x);
+    }
+    iterator insert(iterator position, const value_type& x)
+    {
+        return t.insert_equal((rep_iterator&)position, x);
+    }
+    template <class InputIterator>
+    void insert(InputIterator first, InputIterator last)
+    {
+        t.insert_equal(first, last);
+    }
+    void insert(initializer_list<value_type> l)
+    {
+        t.insert_equal(l.begin(), l.end());
+    }
+    template <class... Args>
+    iterator emplace(Args&&... args)
+    {
+        return t.emplace_equal(std::forward<Args>(args)...);
+    }
+
+    void erase(iterator position) { t.erase((rep_iterator&)position); }
+    size_type erase(const key_type& x) { return t.erase(x); }
+    void erase(iterator first, iterator last) { t.erase((rep_iterator&)first, (rep_iterator&)last); }
+    void clear() { t.clear(); }
+
+    iterator find(const key_type& x) const { return t.find(x); }
+    size_type count(const key_type& x) const { return t.count(x); }
+    iterator lower_bound(const key_type& x) const { return t.lower_bound(x); }
+    iterator upper_bound(const key_type& x) const { return t.upper_bound(x); }
+    pair<iterator, iterator> equal_range(const key_type& x) const { return t.equal_range(x); }
+    //Ƚ׼is_transparentʱֱkey_typeȽϵͲ
+    template <class K, class C = Compare, class = typename C::is_transparent>
+    iterator find(const K& x) const { return t.find(x); }
+    template <class K, class C = Compare, class = typename C::is_transparent>
+    size_type count(const K& x) const { return t.count(x); }
+    template <class K, class C = Compare, class = typename C::is_transparent>
+    iterator lower_bound(const K& x) const { return t.lower_bound(x); }
+    template <class K, class C = Compare, class = typename C::is_transparent>
+    iterator upper_bound(const K& x) const { return t.upper_bound(x); }
+    template <class K, class C = Compare, class = typename C::is_transparent>
+    pair<iterator, iterator> equal_range(const K& x) const { return t.equal_range(x); }
+
+    //ֵظֻṩзֺƴӣrb_treeͬ
+    void split(const key_type& k, my_multiset& right) { t.split(k, right.t); }
+    void join(my_multiset& right) { t.join(right.t); }
+
+    frozen_type freeze() const
+    {
+        return t.freeze();
+    }
+    template <class OutputIterator>
+    OutputIterator split_range(size_type depth, OutputIterator out) const
+    {
+        return t.split_range(depth, out);
+    }
+    template <class Function>
+    void parallel_for_each(Function f) const
+    {
+        t.parallel_for_each(f);
+    }
+    template <class U, class Accumulate, class Combine>
+    U parallel_reduce(U identity, Accumulate acc, Combine combine) const
+    {
+        return t.parallel_reduce(identity, acc, combine);
+    }
+    template <class U, class BinaryOperation>
+    U parallel_reduce(U identity, BinaryOperation op) const
+    {
+        return t.parallel_reduce(identity, op);
+    }
+    template <class RandomAccessIterator, class OutputIterator>
+    OutputIterator find_batch(RandomAccessIterator keys, size_type n, OutputIterator out) const
+    {
+        return t.find_batch(keys, n, out);
+    }
+    //б浽ļʹO(n)ؽҪmy_stl_serialize.hrb_treesave_binaryload_binary
+    friend bool save_binary(const char* path, const my_multiset& x)
+    {
+        return save_binary(path, x.t);
+    }
+    friend bool load_binary(const char* path, my_multiset& x)
+    {
+        return load_binary(path, x.t, false);
+    }
+};
+
+template <class Key, class Compare, class Alloc>
+inline bool operator==(const my_multiset<Key, Compare, Alloc>& x, const my_multiset<Key, Compare, Alloc>& y)
+{
+    return x.size() == y.size() && equal(x.begin(), x.end(), y.begin());
+}
+
+template <class Key, class Compare, class Alloc>
+inline bool operator<(const my_multiset<Key, Compare, Alloc>& x, const my_multiset<Key, Compare, Alloc>& y)
+{
+    return lexicographical_compare(x.begin(), x.end(), y.begin(), y.end());
+}
+#endif //__MY_STL_SET_H
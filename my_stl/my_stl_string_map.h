@@ -0,0 +1,275 @@
+#ifndef __MY_STL_STRING_MAP_H
+#define __MY_STL_STRING_MAP_H
+#include <stdint.h>
+#include <string.h>
+#include <string>
+#include <tuple>
+#include <utility>
+#if __cplusplus >= 201703L
+#include <string_view>
+#endif
+#include "my_stl_alloc.h"
+#include "my_stl_tree.h"
+using namespace std;
+
+//ַΪӳ䣺Ᵽǰ8ֽƴɵ޷8ֽڲ0λǰ
+//ĴС˳ַunsigned charֽڱȽϵ˳һ£ǰ׺ͬʱһȽϾ͵ó
+//ֻǰ׺ͬʱȥַڶϵݣΪֵһִڵУǰ׺Ҳڵһ
+
+//ȡsǰ8ֽΪǰ׺
+inline uint64_t __string_prefix(const char* s, size_t n)
+{
+    uint64_t p = 0;
+    for (size_t i = 0; i < 8; ++i)
+    {
+        p = (p << 8) | (i < n ? (unsigned char)s[i] : 0);
+    }
+    return p;
+}
+
+//ǰ׺ͬʱȽַǰmin(8, an, bn)ֽѾȷ
+inline bool __string_less(uint64_t ap, const char* a, size_t an, uint64_t bp, const char* b, size_t bn)
+{
+    if (ap != bp)
+    {
+        return ap < bp;
+    }
+    size_t n = an < bn ? an : bn;
+    size_t skip = n < 8 ? n : 8;
+    int r = memcmp(a + skip, b + skip, n - skip);
+    return r != 0 ? r < 0 : an < bn;
+}
+
+//ǰ׺ַΪmy_string_mapļ
+class my_prefixed_string
+{
+public:
+    my_prefixed_string() : prefix_(0) {}
+    my_prefixed_string(const string& s) : str_(s), prefix_(__string_prefix(s.data(), s.size())) {}
+    my_prefixed_string(const char* s) : str_(s), prefix_(__string_prefix(str_.data(), str_.size())) {}
+
+    const string& str() const
+    {
+        return str_;
+    }
+    operator const string&() const
+    {
+        return str_;
+    }
+    uint64_t prefix() const
+    {
+        return prefix_;
+    }
+    const char* data() const
+    {
+        return str_.data();
+    }
+    size_t size() const
+    {
+        return str_.size();
+    }
+
+private:
+    string str_;
+    uint64_t prefix_;
+};
+
+//ʱʹõļֻõߵַƣǰ׺ڲҿʼʱһ
+struct __string_probe
+{
+    uint64_t prefix;
+    const char* data;
+    size_t size;
+
+    __string_probe(const char* s, size_t n) : prefix(__string_prefix(s, n)), data(s), size(n) {}
+};
+
+//͸Ƚ׼my_prefixed_string֮Լ__string_probe֮䶼ԱȽ
+struct __prefixed_string_less
+{
+    typedef void is_transparent;
+
+    bool operator()(const my_prefixed_string& x, const my_prefixed_string& y) const
+    {
+        return __string_less(x.prefix(), x.data(), x.size(), y.prefix(), y.data(), y.size());
+    }
+    bool operator()(const my_prefixed_string& x, const __string_probe& y) const
+    {
+        return __string_less(x.prefix(), x.data(), x.size(), y.prefix, y.data, y.size);
+    }
+    bool operator()(const __string_probe& x, const my_prefixed_string& y) const
+    {
+        return __string_less(x.prefix, x.data, x.size, y.prefix(), y.data(), y.size());
+    }
+};
+
+template <class T, class Alloc = my_alloc>
+class my_string_map
+{
+public:
+    typedef my_prefixed_string key_type;
+    typedef T mapped_type;
+    typedef pair<const my_prefixed_string, T> value_type;
+    typedef __prefixed_string_less key_compare;
+
+private:
+    typedef rb_tree<key_type, value_type, my_select1st<value_type>, key_compare, Alloc> rep_type;
+    rep_type t;
+
+    static __string_probe probe(const string& k)
+    {
+        return __string_probe(k.data(), k.size());
+    }
+    static __string_probe probe(const char* k)
+    {
+        return __string_probe(k, strlen(k));
+    }
+
+public:
+    typedef typename rep_type::pointer pointer;
+    typedef typename rep_type::const_pointer const_pointer;
+    typedef typename rep_type::reference reference;
+    typedef typename rep_type::const_reference const_reference;
+    typedef typename rep_type::iterator iterator;
+    typedef typename rep_type::const_iterator const_iterator;
+    typedef typename rep_type::size_type size_type;
+    typedef typename rep_type::difference_type difference_type;
+
+    my_string_map() {}
+    template <class InputIterator>
+    my_string_map(InputIterator first, InputIterator last)
+    {
+        for (; first != last; ++first)
+        {
+            insert(*first);
+        }
+    }
+
+    iterator begin()
+    {
+        return t.begin();
+    }
+    iterator end()
+    {
+        return t.end();
+    }
+    const_iterator begin() const
+    {
+        return t.begin();
+    }
+    const_iterator end() const
+    {
+        return t.end();
+    }
+    bool empty() const
+    {
+        return t.empty();
+    }
+    size_type size() const
+    {
+        return t.size();
+    }
+    void clear()
+    {
+        t.clear();
+    }
+
+    //ʱstringֻڵߵַϱȽ
+    iterator find(const string& k)
+    {
+        return t.find(probe(k));
+    }
+    const_iterator find(const string& k) const
+    {
+        return t.find(probe(k));
+    }
+    iterator find(const char* k)
+    {
+        return t.find(probe(k));
+    }
+    const_iterator find(const char* k) const
+    {
+        return t.find(probe(k));
+    }
+    iterator lower_bound(const string& k)
+    {
+        return t.lower_bound(probe(k));
+    }
+    const_iterator lower_bound(const string& k) const
+    {
+        return t.lower_bound(probe(k));
+    }
+    iterator upper_bound(const string& k)
+    {
+        return t.upper_bound(probe(k));
+    }
+    const_iterator upper_bound(const string& k) const
+    {
+        return t.upper_bound(probe(k));
+    }
+    size_type count(const string& k) const
+    {
+        return find(k) == end() ? 0 : 1;
+    }
+#if __cplusplus >= 201703L
+    iterator find(string_view k)
+    {
+        return t.find(__string_probe(k.data(), k.size()));
+    }
+    const_iterator find(string_view k) const
+    {
+        return t.find(__string_probe(k.data(), k.size()));
+    }
+    iterator lower_bound(string_view k)
+    {
+        return t.lower_bound(__string_probe(k.data(), k.size()));
+    }
+    const_iterator lower_bound(string_view k) const
+    {
+        return t.lower_bound(__string_probe(k.data(), k.size()));
+    }
+    iterator upper_bound(string_view k)
+    {
+        return t.upper_bound(__string_probe(k.data(), k.size()));
+    }
+    const_iterator upper_bound(string_view k) const
+    {
+        return t.upper_bound(__string_probe(k.data(), k.size()));
+    }
+    size_type count(string_view k) const
+    {
+        return find(k) == end() ? 0 : 1;
+    }
+#endif
+
+    //Ѵʱԭֵ
+    pair<iterator, bool> insert(const value_type& x)
+    {
+        return t.insert_unique(x);
+    }
+    pair<iterator, bool> insert(const pair<string, T>& x)
+    {
+        return t.insert_unique(value_type(x.first, x.second));
+    }
+    //òƵ̽½һΣʱҵλϾ͵عֵ
+    T& operator[](const string& k)
+    {
+        return (*t.emplace_unique_key(probe(k), piecewise_construct, forward_as_tuple(k), tuple<>()).first).second;
+    }
+
+    void erase(iterator position)
+    {
+        t.erase(position);
+    }
+    size_type erase(const string& k)
+    {
+        iterator it = find(k);
+        if (it == end())
+        {
+            return 0;
+        }
+        t.erase(it);
+        return 1;
+    }
+};
+#endif //__MY_STL_STRING_MAP_H
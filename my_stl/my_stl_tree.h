@@ -1,6 +1,9 @@
 #ifndef __MY_STL_TREE_H
 #define __MY_STL_TREE_H
+#include <atomic>
 #include <iterator>
+#include <stdint.h>
+#include <thread>
 #include "my_stl_alloc.h"
 #include "my_stl_construct.h"
 
@@ -19,16 +22,80 @@ struct my_identity
     }
 };
 
+//ȡpairfirstΪpairΪֵʹ
+template<class _Pair>
+struct my_select1st
+{
+    using type = typename _Pair::first_type;
+
+    const type& operator()(const _Pair& _Left) const
+    {
+        return (_Left.first);
+    }
+};
+
+//ʾCPUǰpڵcache linepΪ0ʱ
+inline void __rb_tree_prefetch(const void* p)
+{
+#if defined(__GNUC__)
+    __builtin_prefetch(p);
+#else
+    (void)p;
+#endif
+}
+
 struct __rb_tree_node_base
 {
     typedef __rb_tree_color_type color_type;
     typedef __rb_tree_node_base* base_ptr;
 
+#ifdef __STL_RB_TREE_COMPACT_NODE
+    //ղ֣ڵָٰ룬ָλΪ0ɫÿڵʡ8ֽ
+    uintptr_t parent_and_color;
+#else
     color_type color;       //ڵɫ
     base_ptr parent;    //ָ򸸽ڵָ
+#endif
     base_ptr left;
     base_ptr right;
 
+    //ڵɫֻͨĸʣֲֵ÷ͬ
+#ifdef __STL_RB_TREE_COMPACT_NODE
+    base_ptr get_parent() const
+    {
+        return (base_ptr)(parent_and_color & ~uintptr_t(1));
+    }
+    void set_parent(base_ptr p)
+    {
+        parent_and_color = (uintptr_t)p | (parent_and_color & 1);
+    }
+    color_type get_color() const
+    {
+        return (color_type)(parent_and_color & 1);
+    }
+    void set_color(color_type c)
+    {
+        parent_and_color = (parent_and_color & ~uintptr_t(1)) | (uintptr_t)(c ? 1 : 0);
+    }
+#else
+    base_ptr get_parent() const
+    {
+        return parent;
+    }
+    void set_parent(base_ptr p)
+    {
+        parent = p;
+    }
+    color_type get_color() const
+    {
+        return color;
+    }
+    void set_color(color_type c)
+    {
+        color = c;
+    }
+#endif
+
     static base_ptr minimum(base_ptr x)
     {
         while (x->left != 0)
@@ -48,6 +115,10 @@ struct __rb_tree_node_base
     }
 };
 
+#ifdef __STL_RB_TREE_COMPACT_NODE
+static_assert(alignof(__rb_tree_node_base) >= 2, "the low bit of a node address must be free");
+#endif
+
 template <class Value>
 struct __rb_tree_node : public __rb_tree_node_base
 {
@@ -77,11 +148,11 @@ struct __rb_tree_base_iterator
         //2ûӽڵ㣬ҳڵ㣬нڵ㲻ǸڵҽڵΪֹ
         else
         {
-            base_ptr y = node->parent;
+            base_ptr y = node->get_parent();
             while (node == y->right)
             {
                 node = y;
-                y = y->parent;
+                y = y->get_parent();
             }
             //3ڵûиڵ㣬ͬʱûҽڵʱںʹһnullڵΪսڵ㣬߻ȡ¸ڵӦһڵ
             //龰4headerڵĸڵǸڵ㣬ҽڵrightmostڵ㣬ڵûҽڵĻжпܲʱnodeָheaderΪսʾһڵend()
@@ -97,8 +168,8 @@ struct __rb_tree_base_iterator
     {
         //״1nodeָheaderڵ㣬headerڵĸڵΪڵ㣬ڵĸڵΪheaderڵ㣬Դ֤ýڵǷΪheaderڵ㡣
         //headerڵǰһڵΪmostrightΪheader->right
-        if (node->color == __rb_tree_red &&
-            node->parent->parent == node)
+        if (node->get_color() == __rb_tree_red &&
+            node->get_parent()->get_parent() == node)
         {
             node = node->right;
         }
@@ -115,11 +186,11 @@ struct __rb_tree_base_iterator
         //״3ûǰһڵΪΪнڵĵһڵ
         else
         {
-            base_ptr y = node->parent;
+            base_ptr y = node->get_parent();
             while (node == y->left)
             {
                 node = y;
-                y = y->parent;
+                y = y->get_parent();
             }
             node = y;
         }
@@ -164,7 +235,7 @@ struct __rb_tree_iterator : public __rb_tree_base_iterator
     }
 
     pointer operator->() const {
-        return *(operator*());
+        return &(operator*());
     }
 
     //ǰ׺++
@@ -198,15 +269,195 @@ struct __rb_tree_iterator : public __rb_tree_base_iterator
     }
 };
 
-template <class Key, class Value, class KeyOfValue, class Compare, class Alloc = my_alloc>
-class rb_tree
+//ڵ²ԣڵͣڽڵṹ仯¼ڵϵĸϢ
+//operator()(x)xӽڵxenabledΪ0ʱɾ·ϸ
+//ĬϲԲκϢڵ__rb_tree_node<Value>еöǿյ
+template <class Value>
+struct __rb_tree_null_node_update
+{
+    typedef __rb_tree_node<Value> node_type;
+    enum { enabled = 0 };
+
+    void operator()(__rb_tree_node_base*) const {}
+};
+
+//ͳƲԣĬϵ__rb_tree_null_statsвǿյҲռrb_treeĿռ䣨Ϊջࣩ
+//__rb_tree_counting_stats󣬲ҡ롢Ѻͼʱͳ½ʵĽڵͱȽϴʱͳת͸ɫ
+struct __rb_tree_null_stats
+{
+    enum { enabled = 0 };
+
+    void count_descent() const {}
+    void count_visit() const {}
+    void count_compare() const {}
+    void count_rotation() const {}
+    void count_recolor(size_t) const {}
+};
+
+struct __rb_tree_counting_stats
+{
+    enum { enabled = 1 };
+
+    //constĲҲҪ
+    mutable size_t descents;    //findinsert_uniqueinsert_equalӸ½ĴѣеÿηѣҲһ
+    mutable size_t visits;      //½ʱĽڵ
+    mutable size_t compares;    //½ʱñȽ׼Ĵ
+    mutable size_t rotations;   //ɾӵʱת
+    mutable size_t recolors;    //ɾӵʱıɫĴ
+
+    __rb_tree_counting_stats()
+    {
+        reset();
+    }
+    void reset()
+    {
+        descents = visits = compares = rotations = recolors = 0;
+    }
+
+    void count_descent() const { ++descents; }
+    void count_visit() const { ++visits; }
+    void count_compare() const { ++compares; }
+    void count_rotation() const { ++rotations; }
+    void count_recolor(size_t n) const { recolors += n; }
+};
+
+//ȫֵĸϢԣNodeUpdateĻϴһͳƶ
+template <class NodeUpdate, class Stats>
+struct __rb_tree_stats_update : public NodeUpdate
+{
+    const Stats* stats;
+
+    explicit __rb_tree_stats_update(const Stats* s) : stats(s) {}
+};
+
+//ȫֵͨת͸ɫֻдͳƶĲԲŻ
+template <class NodeUpdate>
+inline void __rb_tree_note_rotation(const NodeUpdate&) {}
+template <class NodeUpdate, class Stats>
+inline void __rb_tree_note_rotation(const __rb_tree_stats_update<NodeUpdate, Stats>& update)
+{
+    update.stats->count_rotation();
+}
+template <class NodeUpdate>
+inline void __rb_tree_note_recolor(const NodeUpdate&, size_t) {}
+template <class NodeUpdate, class Stats>
+inline void __rb_tree_note_recolor(const __rb_tree_stats_update<NodeUpdate, Stats>& update, size_t n)
+{
+    update.stats->count_recolor(n);
+}
+
+//rb_treeĽڵԴĬֱʹAllocľ̬ӿڣһջ
+template <class Node, class Alloc>
+struct __rb_tree_node_store
+{
+    enum { pooled = 0 };
+
+    Node* allocate_node()
+    {
+        return simple_alloc<Node, Alloc>::allocate();
+    }
+    void deallocate_node(Node* p)
+    {
+        simple_alloc<Node, Alloc>::deallocate(p);
+    }
+    void allocate_nodes(Node** out, size_t count)
+    {
+        simple_alloc<Node, Alloc>::allocate_batch(out, count);
+    }
+    void release_nodes() {}
+    void splice_nodes(__rb_tree_node_store&) {}
+    void share_nodes(__rb_tree_node_store&) {}
+};
+
+//AllocΪmy_pool_allocʱÿԴһڵأһĽڵ㼯ԼڴУĶ󽻴
+//ֵҪʱclearֱӹ黹أͷŽڵ
+//ѳȥĽڵԭڴͬЩڴ
+template <class Node, class Alloc>
+struct __rb_tree_node_store<Node, my_pool_alloc<Alloc> >
+{
+    enum { pooled = 1 };
+
+    __object_pool<Node, Alloc> node_pool;
+
+    Node* allocate_node()
+    {
+        return node_pool.allocate();
+    }
+    void deallocate_node(Node* p)
+    {
+        node_pool.deallocate(p);
+    }
+    void allocate_nodes(Node** out, size_t count)
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            out[i] = node_pool.allocate();
+        }
+    }
+    void release_nodes()
+    {
+        node_pool.release();
+    }
+    //ڵҪxᵽ*thisʱͬxڴһӹ
+    void splice_nodes(__rb_tree_node_store& x)
+    {
+        node_pool.splice(x.node_pool);
+    }
+    //*thisĽڵҪxʱx*thisͬеڴ
+    void share_nodes(__rb_tree_node_store& x)
+    {
+        node_pool.share(x.node_pool);
+    }
+};
+
+//ڵ²ṩ̬size(x)ڵ˳ͳʱѺߵĽڵֱӴӸ϶
+template <class NodeUpdate>
+struct __rb_tree_has_subtree_size
+{
+    template <class U>
+    static char test(decltype(U::size((__rb_tree_node_base*)0))*);
+    template <class U>
+    static long test(...);
+    enum { value = sizeof(test<NodeUpdate>(0)) == 1 };
+};
+
+template <class NodeUpdate, bool HasSize = __rb_tree_has_subtree_size<NodeUpdate>::value>
+struct __rb_tree_subtree_count
+{
+    enum { known = 0 };
+
+    static size_t count(__rb_tree_node_base*)
+    {
+        return 0;
+    }
+};
+
+template <class NodeUpdate>
+struct __rb_tree_subtree_count<NodeUpdate, true>
+{
+    enum { known = 1 };
+
+    static size_t count(__rb_tree_node_base* x)
+    {
+        return NodeUpdate::size(x);
+    }
+};
+
+template <class Key, class Value, class KeyOfValue, class Compare, class Alloc>
+class frozen_rb_tree;
+
+template <class Key, class Value, class KeyOfValue, class Compare, class Alloc = my_alloc,
+    class NodeUpdate = __rb_tree_null_node_update<Value>, class Stats = __rb_tree_null_stats>
+class rb_tree : protected Stats, protected __rb_tree_node_store<typename NodeUpdate::node_type, Alloc>
 {
 protected:
     typedef void* void_pointer;
     typedef __rb_tree_node_base* base_ptr;
-    typedef __rb_tree_node<Value> rb_tree_node;
+    typedef typename NodeUpdate::node_type rb_tree_node;
     typedef simple_alloc<rb_tree_node, Alloc> rb_tree_node_allocator;
+    typedef __rb_tree_node_store<rb_tree_node, Alloc> node_store;
     typedef __rb_tree_color_type color_type;
+    typedef __rb_tree_stats_update<NodeUpdate, Stats> stats_update;
 
 public:
     typedef Key key_type;
@@ -222,16 +473,21 @@ public:
 protected:
     link_type get_node()
     {
-        return rb_tree_node_allocator::allocate();
+        return this->allocate_node();
     }
     void put_node(link_type p)
     {
-        rb_tree_node_allocator::deallocate(p);
+        this->deallocate_node(p);
     }
 
     link_type create_node(const value_type& x)
     {
-        link_type tmp = get_node();
+        return construct_node(get_node(), x);
+    }
+
+    //ѾúõĽڵϹֵ
+    link_type construct_node(link_type tmp, const value_type& x)
+    {
         try
         {
             construct(&tmp->value_field, x);
@@ -245,10 +501,87 @@ protected:
         return tmp;
     }
 
-    link_type clone_node(link_type x)       //һڵֵɫ
+    //ֱargsڽڵйֵʱvalue_type
+    template <class... Args>
+    link_type emplace_node(Args&&... args)
+    {
+        link_type tmp = get_node();
+        try
+        {
+            construct(&tmp->value_field, std::forward<Args>(args)...);
+        }
+        catch (...)
+        {
+            put_node(tmp);
+            exit(1);
+        }
+        return tmp;
+    }
+
+    //ʱҪڵ㣬ÿڵڴ
+    struct node_batch
+    {
+        enum { batch_size = 256 };
+        link_type nodes[batch_size];
+        size_type pos;
+        size_type count;
+        size_type remaining;    //ҪõĽڵ
+        node_store* store;
+
+        node_batch(size_type n, node_store* s) : pos(0), count(0), remaining(n), store(s) {}
+
+        link_type next()
+        {
+            if (pos == count)
+            {
+                count = remaining < size_type(batch_size) ? remaining : size_type(batch_size);
+                store->allocate_nodes(nodes, count);
+                remaining -= count;
+                pos = 0;
+            }
+            return nodes[pos++];
+        }
+    };
+
+    //иʱ̹߳һԤúõĽڵ飬ÿԭӲȡһΣȡߵλ
+    struct clone_pool
+    {
+        enum { chunk_size = 256 };
+        link_type* nodes;
+        size_type total;
+        std::atomic<size_type> claimed;
+    };
+    //ÿ߳һclone_poolȡڵ
+    struct clone_cursor
+    {
+        clone_pool* pool;
+        size_type pos;
+        size_type end;
+
+        explicit clone_cursor(clone_pool* p) : pool(p), pos(0), end(0) {}
+
+        link_type next()
+        {
+            if (pos == end)
+            {
+                pos = pool->claimed.fetch_add(size_type(clone_pool::chunk_size));
+                end = pos + size_type(clone_pool::chunk_size);
+                if (end > pool->total)
+                {
+                    end = pool->total;
+                }
+            }
+            link_type tmp = pool->nodes[pos];
+            pool->nodes[pos++] = 0;
+            return tmp;
+        }
+    };
+    typedef simple_alloc<link_type, Alloc> link_allocator;
+
+    link_type clone_node(link_type x, link_type tmp)       //ѾúõĽڵtmpϸxֵɫ
     {
-        link_type tmp = create_node(x->value_field);
-        tmp->color = x->color;
+        construct_node(tmp, x->value_field);
+        tmp->set_color(x->get_color());
         tmp->left = 0;
         tmp->right = 0;
         return tmp;
@@ -266,8 +599,12 @@ protected:
     Compare key_compare;    //ڵ֮ļֱСȽ׼Ӧûһº
 
     //һȡheaderĳԱ
-    link_type& root() const {
-        return (link_type&)header->parent;
+    link_type root() const {
+        return (link_type)header->get_parent();
+    }
+    void set_root(link_type x) const
+    {
+        header->set_parent(x);
     }
     link_type& leftmost() const
     {
@@ -286,9 +623,9 @@ protected:
     {
         return (link_type&)(x->right);
     }
-    static link_type& parent(link_type x)
+    static link_type parent(link_type x)
     {
-        return (link_type&)(x->parent);
+        return (link_type)x->get_parent();
     }
     static reference value(link_type x)
     {
@@ -298,9 +635,9 @@ protected:
     {
         return KeyOfValue()(value(x));
     }
-    static color_type& color(link_type x)
+    static color_type color(link_type x)
     {
-        return (color_type&)(x->color);
+        return x->get_color();
     }
 
     //6ȡýڵxĳԱ,൱
@@ -312,9 +649,13 @@ protected:
     {
         return (link_type&)(x->right);
     }
-    static link_type& parent(base_ptr x)
+    static link_type parent(base_ptr x)
+    {
+        return (link_type)x->get_parent();
+    }
+    static void set_parent(base_ptr x, base_ptr p)
     {
-        return (link_type&)(x->parent);
+        x->set_parent(p);
     }
     static reference value(base_ptr x)
     {
@@ -324,9 +665,13 @@ protected:
     {
         return KeyOfValue()(value(link_type(x)));
     }
-    static color_type& color(base_ptr x)
+    static color_type color(base_ptr x)
     {
-        return (color_type&)(link_type(x)->color);
+        return x->get_color();
+    }
+    static void set_color(base_ptr x, color_type c)
+    {
+        x->set_color(c);
     }
 
     //󼫴ֵͼСֵ
@@ -346,8 +691,26 @@ public:
     typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
 
 private:
-    iterator __insert(base_ptr x, base_ptr y, const value_type& v);
-    link_type __copy(link_type x, link_type p);
+    iterator __insert(base_ptr x, base_ptr y, const value_type& v)
+    {
+        return __insert_node(x, y, create_node(v));
+    }
+    iterator __insert_node(base_ptr x, base_ptr y, link_type z);
+    //k½һΣkʱ(0, ½ڵĸڵ)Ѵʱ(ΪkĽڵ, 0)
+    template <class K>
+    pair<link_type, link_type> __insert_unique_pos(const K& k);
+    //ظʱ½ڵĸڵ㣬ȵļе֮
+    link_type __insert_equal_pos(const Key& k);
+    link_type __copy(link_type x, link_type p, size_type n);
+    template <class NodeSource>
+    link_type __copy_subtree(link_type x, link_type p, NodeSource& nodes);
+    link_type __copy_parallel(link_type x, link_type p, clone_cursor& nodes, size_type par_depth);
+    template <class InputIterator>
+    link_type __build_sorted(InputIterator& first, size_type n, size_type depth, size_type red_depth, node_batch& batch);
+    template <class InputIterator>
+    void __insert_range(InputIterator first, InputIterator last, bool unique, input_iterator_tag);
+    template <class ForwardIterator>
+    void __insert_range(ForwardIterator first, ForwardIterator last, bool unique, forward_iterator_tag);
     void __erase(link_type x)
     {
         while (x != 0) {
@@ -357,21 +720,150 @@ private:
             x = y;
         }
     }
-    void init()
+    //½һҵ߽ڵ㣬Ҳʱheader
+    //KԲKeyֻҪkey_compareܱȽKKey͸Ƚ׼칹ң
+    template <class K>
+    link_type __lower_bound(const K& k) const
     {
-        header = get_node();
-        color(header) = __rb_tree_red;
-        root() = 0;
-        leftmost() = header;
-        rightmost() = header;
+        link_type y = header;
+        link_type x = root();
+        this->count_descent();
+        while (x != 0)
+        {
+            this->count_visit();
+            this->count_compare();
+            if (!key_compare(key(x), k))
+            {
+                y = x;
+                x = left(x);
+            }
+            else
+            {
+                x = right(x);
+            }
+        }
+        return y;
     }
-    void clear()
+    enum { find_batch_width = 16 };     //ʱͬʱ½ļ
+    template <class RandomAccessIterator>
+    void __find_group(RandomAccessIterator keys, size_type n, link_type* result) const;
+    template <class K>
+    link_type __upper_bound(const K& k) const
+    {
+        link_type y = header;
+        link_type x = root();
+        while (x != 0)
+        {
+            if (key_compare(k, key(x)))
+            {
+                y = x;
+                x = left(x);
+            }
+            else
+            {
+                x = right(x);
+            }
+        }
+        return y;
+    }
+    //ϲõΪ0ߺɫbhΪڸߣӸ·ϵĺڽڵ
+    struct subtree
+    {
+        base_ptr root;
+        size_type bh;
+    };
+    //ʹõĽڵ㣬rightڵ߳ͳһͷ
+    struct node_list
+    {
+        base_ptr head;
+        base_ptr tail;
+
+        node_list() : head(0), tail(0) {}
+        void push(base_ptr x)
+        {
+            x->right = 0;
+            if (tail != 0)
+            {
+                tail->right = x;
+            }
+            else
+            {
+                head = x;
+            }
+            tail = x;
+        }
+        void push_subtree(base_ptr x)
+        {
+            while (x != 0)
+            {
+                push_subtree(x->left);
+                base_ptr r = x->right;
+                push(x);
+                x = r;
+            }
+        }
+        void splice(node_list& x)
+        {
+            if (x.head == 0)
+            {
+                return;
+            }
+            if (tail != 0)
+            {
+                tail->right = x.head;
+            }
+            else
+            {
+                head = x.head;
+            }
+            tail = x.tail;
+        }
+    };
+    enum { parallel_threshold = 1 << 16 };  //ϼƳôڵʱſ߳
+
+    static subtree make_subtree(base_ptr root, size_type bh)
     {
-        __erase(root());
+        subtree t = { root, bh };
+        return t;
+    }
+    static subtree expose_child(base_ptr x, size_type parent_bh);
+    subtree release_root();
+    void adopt_root(subtree t, size_type n);
+    subtree __join(subtree l, base_ptr k, subtree r) const;
+    subtree __join2(subtree l, subtree r) const;
+    void __split(subtree t, const Key& k, subtree& l, base_ptr& m, subtree& r) const;
+    void __split_lower(subtree t, const Key& k, subtree& l, subtree& r) const;
+    void __split_last(subtree t, subtree& l, base_ptr& m) const;
+    subtree __union(subtree a, subtree b, node_list& garbage, size_type par_depth) const;
+    subtree __intersect(subtree a, subtree b, node_list& garbage, size_type par_depth) const;
+    subtree __difference(subtree a, subtree b, node_list& garbage, size_type par_depth) const;
+    static size_type parallel_depth(size_type n);
+    size_type free_list(node_list& garbage);
+
+    enum { range_split_levels = 3 };    //бʱÿ߳ƽֵ2^3
+    //бֳɵĶ߳ʱΪ1
+    size_type parallel_ranges() const
+    {
+        size_type par_depth = parallel_depth(size());
+        return par_depth == 0 ? 1 : size_type(1) << (par_depth + size_type(range_split_levels));
+    }
+    static link_type* __range_bounds(link_type x, size_type depth, link_type* out);
+    template <class Iterator, class OutputIterator>
+    OutputIterator __split_range(size_type depth, OutputIterator out) const;
+    template <class Task>
+    void __run_ranges(Task& task) const;
+
+    static size_type __height(base_ptr x);
+    static int __verify_subtree(base_ptr x, const Compare& comp);
+
+    void init()
+    {
+        //headerӽڵãع黹ʱӰ
+        header = rb_tree_node_allocator::allocate();
+        set_color(header, __rb_tree_red);
+        set_root(0);
         leftmost() = header;
-        root() = 0;
         rightmost() = header;
-        node_count = 0;
     }
 
 public:
@@ -380,15 +872,28 @@ public:
         init();
     }
 
+    //ڵһúãֵƽҽڵܶʱֵĸƺӷָ߳
+    rb_tree(const rb_tree& x) : node_count(0), key_compare(x.key_compare)
+    {
+        init();
+        if (x.root() != 0)
+        {
+            node_count = x.size();
+            set_root(__copy(x.root(), header, node_count));
+            leftmost() = minimum(root());
+            rightmost() = maximum(root());
+        }
+    }
+
     ~rb_tree()
     {
         clear();
-        put_node(header);
+        rb_tree_node_allocator::deallocate(header);
     }
 
-    rb_tree<Key, Value, KeyOfValue, Compare, Alloc>& operator=(const rb_tree<Key, Value, KeyOfValue, Compare, Alloc>& x);
+    rb_tree<Key, Value, KeyOfValue, Compare, Alloc, NodeUpdate, Stats>& operator=(const rb_tree<Key, Value, KeyOfValue, Compare, Alloc, NodeUpdate, Stats>& x);
 public:
-    Compare Key_comp() const {
+    Compare key_comp() const {
         return key_compare;
     }
     iterator begin()
@@ -410,7 +915,7 @@ public:
         return const_reverse_iterator(begin());
     }
     bool empty() const {
-        return node_count == 0;
+        return root() == 0;
     }
     size_type size() const
     {
@@ -422,58 +927,325 @@ public:
     }
     iterator find(const Key &k)
     {
-        link_type y = header;
-        link_type x = root();
+        iterator j = iterator(__lower_bound(k));
+        this->count_compare();
+        return (j == end() || key_compare(k, key(j.node))) ? end() : j;
+    }
+    const_iterator find(const Key &k) const
+    {
+        const_iterator j = const_iterator(__lower_bound(k));
+        this->count_compare();
+        return (j == end() || key_compare(k, key(j.node))) ? end() : j;
+    }
 
-        while (x != 0)
+    //Ƚ׼is_transparentʱֱKeyȽϵͲңȹһKey
+    template <class K, class C = Compare, class = typename C::is_transparent>
+    iterator find(const K& k)
+    {
+        iterator j = iterator(__lower_bound(k));
+        this->count_compare();
+        return (j == end() || key_compare(k, key(j.node))) ? end() : j;
+    }
+    template <class K, class C = Compare, class = typename C::is_transparent>
+    const_iterator find(const K& k) const
+    {
+        const_iterator j = const_iterator(__lower_bound(k));
+        this->count_compare();
+        return (j == end() || key_compare(k, key(j.node))) ? end() : j;
+    }
+
+    //ңÿfind_batch_widthͬʱӸ½һһڵ㷢Ԥȡ
+    //һȴڴʱıȽճУΰkeys[0..n)ĲҽдoutûҵʱΪend()
+    template <class RandomAccessIterator, class OutputIterator>
+    OutputIterator find_batch(RandomAccessIterator keys, size_type n, OutputIterator out)
+    {
+        link_type result[find_batch_width];
+        for (size_type i = 0; i < n; i += size_type(find_batch_width))
         {
-            if (!key_compare(key(x), k))
+            size_type m = n - i < size_type(find_batch_width) ? n - i : size_type(find_batch_width);
+            __find_group(keys + i, m, result);
+            for (size_type j = 0; j < m; ++j)
             {
-                y = x;
-                x = left(x);
+                *out++ = iterator(result[j]);
             }
-            else
+        }
+        return out;
+    }
+    template <class RandomAccessIterator, class OutputIterator>
+    OutputIterator find_batch(RandomAccessIterator keys, size_type n, OutputIterator out) const
+    {
+        link_type result[find_batch_width];
+        for (size_type i = 0; i < n; i += size_type(find_batch_width))
+        {
+            size_type m = n - i < size_type(find_batch_width) ? n - i : size_type(find_batch_width);
+            __find_group(keys + i, m, result);
+            for (size_type j = 0; j < m; ++j)
             {
-                x = right(x);
+                *out++ = const_iterator(result[j]);
             }
         }
-        iterator j = iterator(y);
-        return (j == end() || key_compare(k, key(j->node))) ? end() : j;
+        return out;
     }
 
-public:
-    //ڵ㣬ظ
-    pair<iterator, bool> insert_unique(const value_type& v);
-    void insert_unique(const_iterator __first, const_iterator __last);
-    //ڵ㣬ظ
-    iterator insert_equal(const value_type& v);
-};
-
-
-
-template <class Key, class Value, class KeyOfValue, class Compare, class Alloc /*= my_alloc*/>
-std::pair<typename rb_tree<Key, Value, KeyOfValue, Compare, Alloc>::iterator, bool> 
-rb_tree<Key, Value, KeyOfValue, Compare, Alloc>::insert_unique(const value_type& v)
-{
-    link_type y = header;
-    link_type x = root();
-
-    bool comp = true;
-    while (x != 0)
+    //һСkĽڵ
+    iterator lower_bound(const Key& k)
     {
-        y = x;
-        comp = key_compare(KeyOfValue()(v), key(x));
-        x = comp ? left(x) : right(x);
+        return iterator(__lower_bound(k));
     }
-
-    iterator j = iterator(y);
-    //ȸڵС
-    if (comp)
+    const_iterator lower_bound(const Key& k) const
     {
-        //龰1ʱСģû⣬ֱ
+        return const_iterator(__lower_bound(k));
+    }
+    //һkĽڵ
+    iterator upper_bound(const Key& k)
+    {
+        return iterator(__upper_bound(k));
+    }
+    const_iterator upper_bound(const Key& k) const
+    {
+        return const_iterator(__upper_bound(k));
+    }
+    template <class K, class C = Compare, class = typename C::is_transparent>
+    iterator lower_bound(const K& k)
+    {
+        return iterator(__lower_bound(k));
+    }
+    template <class K, class C = Compare, class = typename C::is_transparent>
+    const_iterator lower_bound(const K& k) const
+    {
+        return const_iterator(__lower_bound(k));
+    }
+    template <class K, class C = Compare, class = typename C::is_transparent>
+    iterator upper_bound(const K& k)
+    {
+        return iterator(__upper_bound(k));
+    }
+    template <class K, class C = Compare, class = typename C::is_transparent>
+    const_iterator upper_bound(const K& k) const
+    {
+        return const_iterator(__upper_bound(k));
+    }
+    pair<iterator, iterator> equal_range(const Key& k)
+    {
+        return pair<iterator, iterator>(lower_bound(k), upper_bound(k));
+    }
+    pair<const_iterator, const_iterator> equal_range(const Key& k) const
+    {
+        return pair<const_iterator, const_iterator>(lower_bound(k), upper_bound(k));
+    }
+    size_type count(const Key& k) const
+    {
+        pair<const_iterator, const_iterator> p = equal_range(k);
+        size_type n = 0;
+        for (; p.first != p.second; ++p.first)
+        {
+            ++n;
+        }
+        return n;
+    }
+    template <class K, class C = Compare, class = typename C::is_transparent>
+    pair<iterator, iterator> equal_range(const K& k)
+    {
+        return pair<iterator, iterator>(lower_bound(k), upper_bound(k));
+    }
+    template <class K, class C = Compare, class = typename C::is_transparent>
+    pair<const_iterator, const_iterator> equal_range(const K& k) const
+    {
+        return pair<const_iterator, const_iterator>(lower_bound(k), upper_bound(k));
+    }
+    template <class K, class C = Compare, class = typename C::is_transparent>
+    size_type count(const K& k) const
+    {
+        pair<const_iterator, const_iterator> p = equal_range(k);
+        size_type n = 0;
+        for (; p.first != p.second; ++p.first)
+        {
+            ++n;
+        }
+        return n;
+    }
+
+    //ηʼֵ[lo, hi)еֵֻӸ½һҵ㣬֮غߣO(log n + k)
+    //طʵĸ
+    template <class Visitor>
+    size_type visit_range(const Key& lo, const Key& hi, Visitor f)
+    {
+        size_type n = 0;
+        for (iterator it = lower_bound(lo); it != end() && key_compare(key(it.node), hi); ++it, ++n)
+        {
+            f(*it);
+        }
+        return n;
+    }
+    template <class Visitor>
+    size_type visit_range(const Key& lo, const Key& hi, Visitor f) const
+    {
+        size_type n = 0;
+        for (const_iterator it = lower_bound(lo); it != end() && key_compare(key(it.node), hi); ++it, ++n)
+        {
+            f(*it);
+        }
+        return n;
+    }
+
+public:
+    //ڵ㣬ظ
+    pair<iterator, bool> insert_unique(const value_type& v);
+    //ʾĲ룺ȼpositionǰھӣλȷʱôӸ½
+    //׷ʱend()ֻҪrightmostȽһ
+    iterator insert_unique(iterator position, const value_type& v);
+    //һУΪźʱֱO(n)end()Ϊʾ
+    template <class InputIterator>
+    void insert_unique(InputIterator first, InputIterator last)
+    {
+        __insert_range(first, last, true, typename iterator_traits<InputIterator>::iterator_category());
+    }
+    //ڵ㣬ظ
+    iterator insert_equal(const value_type& v);
+    iterator insert_equal(iterator position, const value_type& v);
+    template <class InputIterator>
+    void insert_equal(InputIterator first, InputIterator last)
+    {
+        __insert_range(first, last, false, typename iterator_traits<InputIterator>::iterator_category());
+    }
+    //args½ڵйֵ룬ظʱ½ڵ
+    template <class... Args>
+    pair<iterator, bool> emplace_unique(Args&&... args);
+    template <class... Args>
+    iterator emplace_equal(Args&&... args);
+    //Ȱk½һΣkʱargs½ڵ㲢ֱӹ½ͣµλãkѴʱargsԭ
+    //my_mapoperator[]try_emplaceinsert_or_assign
+    template <class K, class... Args>
+    pair<iterator, bool> emplace_unique_key(const K& k, Args&&... args);
+
+    //ɾڵ㣬ͷŵĽڵ黹ڵfree list´βֱӸ
+    void erase(iterator position);
+    size_type erase(const Key& k);
+    void erase(iterator first, iterator last);
+    void clear()
+    {
+        if (node_store::pooled && is_trivially_destructible<value_type>::value)
+        {
+            //ڵ㶼ԼĳֵҲҪع黹
+            this->release_nodes();
+        }
+        else
+        {
+            __erase(root());
+        }
+        leftmost() = header;
+        set_root(0);
+        rightmost() = header;
+        node_count = 0;
+    }
+    //ã·ϵĽڵO(n)
+    size_type height() const
+    {
+        return __height(root());
+    }
+    //Ӹһ·ϵĺڽڵO(log n)
+    size_type black_height() const
+    {
+        size_type bh = 0;
+        for (base_ptr x = root(); x != 0; x = x->left)
+        {
+            bh += x->get_color() == __rb_tree_black;
+        }
+        return bh;
+    }
+    //ȫʡӡ˳leftmost/rightmostnode_countO(n)
+    bool __rb_verify() const;
+    //ͳƲԶ󣬼ͨȡ
+    const Stats& stats() const
+    {
+        return *this;
+    }
+    Stats& stats()
+    {
+        return *this;
+    }
+
+    //ֻEytzingerգ䣬O(n)my_stl_frozen_tree.hУʹʱҪͷļ
+    frozen_rb_tree<Key, Value, KeyOfValue, Compare, Alloc> freeze() const;
+
+    //պ[first, first + n)ֱӽ֤߱ѰֵźO(n)
+    //ڵãleftmostrightmostnode_countֱ
+    template <class InputIterator>
+    void assign_sorted(InputIterator first, size_type n);
+
+    //²ֱӰƽڵ㣬ãһʹͬıȽ׼
+    //нСmڵ㡢ϴnʱȽϴΪO(m log(n/m + 1))ڵܶʱڲͬ߳м㣬
+    //ͳƲʱԭӵģֻڵ߳н
+    //*thisСkֵģмkģƵrightrightԭеֵright*this
+    //ڵСʱO(log n)ߵĽڵҪO(log n + min(, ))
+    void split(const Key& k, rb_tree& right);
+    //rightֵ*this棬֤߱*thisļСrightļrightգrightΪ*thisʱκ£O(log n)
+    void join(rb_tree& right);
+    //߶еļ*thisеֵxգxΪ*thisʱ
+    void union_with(rb_tree& x);
+    //ֻxҲеļxգxΪ*thisʱ
+    void intersect_with(rb_tree& x);
+    //ɾxҲеļxգxΪ*thisʱ
+    void difference_with(rb_tree& x);
+
+    //Ľṹ[begin(), end())г2^depthΣpair<iterator, iterator>дout
+    //еСdepthĽڵ㣬ÿһеһΪdepthɣοΪ
+    template <class OutputIterator>
+    OutputIterator split_range(size_type depth, OutputIterator out)
+    {
+        return __split_range<iterator>(depth, out);
+    }
+    template <class OutputIterator>
+    OutputIterator split_range(size_type depth, OutputIterator out) const
+    {
+        return __split_range<const_iterator>(depth, out);
+    }
+    //ÿֵfڵܶʱгɶηָ̣̹߳߳ͬһf˳ȷ
+    template <class Function>
+    void parallel_for_each(Function f);
+    template <class Function>
+    void parallel_for_each(Function f) const;
+    //ÿδidentityʼaccۻεĽٰcombineϲ
+    //identitycombineĵλԪcombineɣ˳ۻͬ
+    template <class T, class Accumulate, class Combine>
+    T parallel_reduce(T identity, Accumulate acc, Combine combine) const;
+    template <class T, class BinaryOperation>
+    T parallel_reduce(T identity, BinaryOperation op) const
+    {
+        return parallel_reduce(identity, op, op);
+    }
+};
+
+
+
+template <class Key, class Value, class KeyOfValue, class Compare, class Alloc, class NodeUpdate, class Stats>
+template <class K>
+std::pair<typename rb_tree<Key, Value, KeyOfValue, Compare, Alloc, NodeUpdate, Stats>::link_type,
+    typename rb_tree<Key, Value, KeyOfValue, Compare, Alloc, NodeUpdate, Stats>::link_type>
+rb_tree<Key, Value, KeyOfValue, Compare, Alloc, NodeUpdate, Stats>::__insert_unique_pos(const K& k)
+{
+    link_type y = header;
+    link_type x = root();
+
+    bool comp = true;
+    this->count_descent();
+    while (x != 0)
+    {
+        y = x;
+        this->count_visit();
+        this->count_compare();
+        comp = key_compare(k, key(x));
+        x = comp ? left(x) : right(x);
+    }
+
+    iterator j = iterator(y);
+    //ȸڵС
+    if (comp)
+    {
+        //龰1ʱСģû⣬ֱ
         if (j == begin())
         {
-            return pair<iterator, bool>(__insert(x, y, v), true);
+            return pair<link_type, link_type>(0, y);
         }
         //jָȸڵСǸڵ
         else
@@ -484,54 +1256,362 @@ rb_tree<Key, Value, KeyOfValue, Compare, Alloc>::insert_unique(const value_type&
 
     //龰2֮ǰȸڵСʱֱȸڵһڵûظ
     //龰3֮ǰڵڸڵ㣬ʱжϸڵǷȸýڵССڵĻҲûظ
-    if (key_compare(key(j.node), KeyOfValue()(v)))
+    this->count_compare();
+    if (key_compare(key(j.node), k))
     {
-        return pair<iterator, bool>(__insert(x, y, v), true);
+        return pair<link_type, link_type>(0, y);
     }
 
     //龰4ˣʾֵһмֵظôֵ
-    return pair<iterator, bool>(j, false);
+    return pair<link_type, link_type>((link_type)j.node, 0);
+}
+
+template <class Key, class Value, class KeyOfValue, class Compare, class Alloc, class NodeUpdate, class Stats>
+std::pair<typename rb_tree<Key, Value, KeyOfValue, Compare, Alloc, NodeUpdate, Stats>::iterator, bool> 
+rb_tree<Key, Value, KeyOfValue, Compare, Alloc, NodeUpdate, Stats>::insert_unique(const value_type& v)
+{
+    pair<link_type, link_type> pos = __insert_unique_pos(KeyOfValue()(v));
+    if (pos.second != 0)
+    {
+        return pair<iterator, bool>(__insert(pos.first, pos.second, v), true);
+    }
+    return pair<iterator, bool>(iterator(pos.first), false);
+}
+
+template <class Key, class Value, class KeyOfValue, class Compare, class Alloc, class NodeUpdate, class Stats>
+template <class... Args>
+std::pair<typename rb_tree<Key, Value, KeyOfValue, Compare, Alloc, NodeUpdate, Stats>::iterator, bool>
+rb_tree<Key, Value, KeyOfValue, Compare, Alloc, NodeUpdate, Stats>::emplace_unique(Args&&... args)
+{
+    //ֵ֪֮
+    link_type z = emplace_node(std::forward<Args>(args)...);
+    pair<link_type, link_type> pos = __insert_unique_pos(key(z));
+    if (pos.second != 0)
+    {
+        return pair<iterator, bool>(__insert_node(pos.first, pos.second, z), true);
+    }
+    destroy_node(z);
+    return pair<iterator, bool>(iterator(pos.first), false);
+}
+
+template <class Key, class Value, class KeyOfValue, class Compare, class Alloc, class NodeUpdate, class Stats>
+template <class... Args>
+typename rb_tree<Key, Value, KeyOfValue, Compare, Alloc, NodeUpdate, Stats>::iterator
+rb_tree<Key, Value, KeyOfValue, Compare, Alloc, NodeUpdate, Stats>::emplace_equal(Args&&... args)
+{
+    link_type z = emplace_node(std::forward<Args>(args)...);
+    return __insert_node(0, __insert_equal_pos(key(z)), z);
+}
+
+template <class Key, class Value, class KeyOfValue, class Compare, class Alloc, class NodeUpdate, class Stats>
+template <class K, class... Args>
+std::pair<typename rb_tree<Key, Value, KeyOfValue, Compare, Alloc, NodeUpdate, Stats>::iterator, bool>
+rb_tree<Key, Value, KeyOfValue, Compare, Alloc, NodeUpdate, Stats>::emplace_unique_key(const K& k, Args&&... args)
+{
+    pair<link_type, link_type> pos = __insert_unique_pos(k);
+    if (pos.second == 0)
+    {
+        return pair<iterator, bool>(iterator(pos.first), false);
+    }
+    return pair<iterator, bool>(__insert_node(pos.first, pos.second, emplace_node(std::forward<Args>(args)...)), true);
+}
+template <class Key, class Value, class KeyOfValue, class Compare, class Alloc, class NodeUpdate, class Stats>
+template <class InputIterator>
+void rb_tree<Key, Value, KeyOfValue, Compare, Alloc, NodeUpdate, Stats>::__insert_range(InputIterator first, InputIterator last, bool unique, input_iterator_tag)
+{
+    for (; first != last; ++first)
+    {
+        if (unique)
+        {
+            insert_unique(end(), *first);
+        }
+        else
+        {
+            insert_equal(end(), *first);
+        }
+    }
+}
+
+//ǰɨһ飺ΪղuniqueʱҪϸֱӽ
+template <class Key, class Value, class KeyOfValue, class Compare, class Alloc, class NodeUpdate, class Stats>
+template <class ForwardIterator>
+void rb_tree<Key, Value, KeyOfValue, Compare, Alloc, NodeUpdate, Stats>::__insert_range(ForwardIterator first, ForwardIterator last, bool unique, forward_iterator_tag)
+{
+    if (empty() && first != last)
+    {
+        bool sorted = true;
+        size_type n = 1;
+        ForwardIterator prev = first;
+        ForwardIterator cur = first;
+        for (++cur; cur != last; prev = cur, ++cur, ++n)
+        {
+            if (unique ? !key_compare(KeyOfValue()(*prev), KeyOfValue()(*cur))
+                : key_compare(KeyOfValue()(*cur), KeyOfValue()(*prev)))
+            {
+                sorted = false;
+                break;
+            }
+        }
+        if (sorted)
+        {
+            assign_sorted(first, n);
+            return;
+        }
+    }
+    __insert_range(first, last, unique, input_iterator_tag());
 }
-template <class Key, class Value, class KeyOfValue, class Compare, class Alloc /*= my_alloc*/>
-void rb_tree<Key, Value, KeyOfValue, Compare, Alloc>::insert_unique(const_iterator __first, const_iterator __last)
+
+template <class Key, class Value, class KeyOfValue, class Compare, class Alloc, class NodeUpdate, class Stats>
+typename rb_tree<Key, Value, KeyOfValue, Compare, Alloc, NodeUpdate, Stats>::iterator
+rb_tree<Key, Value, KeyOfValue, Compare, Alloc, NodeUpdate, Stats>::insert_unique(iterator position, const value_type& v)
 {
-    for (; __first != __last; ++__first)
-        insert_unique(*__first);
+    const Key& k = KeyOfValue()(v);
+    if (position.node == header->left)
+    {
+        //ʾΪbegin()СֵС͹leftmost
+        if (!empty() && key_compare(k, key(position.node)))
+        {
+            return __insert(position.node, position.node, v);
+        }
+    }
+    else if (position.node == header)
+    {
+        //ʾΪend()ֵ͹rightmostұ
+        if (key_compare(key(rightmost()), k))
+        {
+            return __insert(0, rightmost(), v);
+        }
+        return insert_unique(v).first;
+    }
+    else
+    {
+        //beforeposition֮
+        iterator before = position;
+        --before;
+        if (key_compare(key(before.node), k) && key_compare(k, key(position.node)))
+        {
+            //beforeûӽڵʱұߣpositionһûӽڵ
+            if (right(before.node) == 0)
+            {
+                return __insert(0, before.node, v);
+            }
+            return __insert(position.node, position.node, v);
+        }
+    }
+
+    //positionafter֮䣬ǰʱһνΪʾ
+    if (position.node != header && key_compare(key(position.node), k))
+    {
+        iterator after = position;
+        ++after;
+        if (after.node == header || key_compare(k, key(after.node)))
+        {
+            if (right(position.node) == 0)
+            {
+                return __insert(0, position.node, v);
+            }
+            return __insert(after.node, after.node, v);
+        }
+    }
+    return insert_unique(v).first;
 }
-template <class Key, class Value, class KeyOfValue, class Compare, class Alloc /*= my_alloc*/>
-typename rb_tree<Key, Value, KeyOfValue, Compare, Alloc>::iterator
- rb_tree<Key, Value, KeyOfValue, Compare, Alloc>::insert_equal(const value_type& v)
+template <class Key, class Value, class KeyOfValue, class Compare, class Alloc, class NodeUpdate, class Stats>
+typename rb_tree<Key, Value, KeyOfValue, Compare, Alloc, NodeUpdate, Stats>::link_type
+rb_tree<Key, Value, KeyOfValue, Compare, Alloc, NodeUpdate, Stats>::__insert_equal_pos(const Key& k)
 {
     link_type y = header;
     link_type x = root();
+    this->count_descent();
     while (x != 0)
     {
         y = x;
+        this->count_visit();
+        this->count_compare();
         //Сڵ
-        x = key_compare(KeyOfValue()(v), key(x)) ? left(x) : right(x);
+        x = key_compare(k, key(x)) ? left(x) : right(x);
+    }
+    return y;
+}
+
+template <class Key, class Value, class KeyOfValue, class Compare, class Alloc, class NodeUpdate, class Stats>
+typename rb_tree<Key, Value, KeyOfValue, Compare, Alloc, NodeUpdate, Stats>::iterator
+ rb_tree<Key, Value, KeyOfValue, Compare, Alloc, NodeUpdate, Stats>::insert_equal(const value_type& v)
+{
+    return __insert(0, __insert_equal_pos(KeyOfValue()(v)), v);
+}
+
+template <class Key, class Value, class KeyOfValue, class Compare, class Alloc, class NodeUpdate, class Stats>
+typename rb_tree<Key, Value, KeyOfValue, Compare, Alloc, NodeUpdate, Stats>::iterator
+rb_tree<Key, Value, KeyOfValue, Compare, Alloc, NodeUpdate, Stats>::insert_equal(iterator position, const value_type& v)
+{
+    //insert_unique(position, v)ֻͬȵļֵҲԲʾλ
+    const Key& k = KeyOfValue()(v);
+    if (position.node == header->left)
+    {
+        if (!empty() && !key_compare(key(position.node), k))
+        {
+            return __insert(position.node, position.node, v);
+        }
+    }
+    else if (position.node == header)
+    {
+        if (!empty() && !key_compare(k, key(rightmost())))
+        {
+            return __insert(0, rightmost(), v);
+        }
+        return insert_equal(v);
+    }
+    else
+    {
+        iterator before = position;
+        --before;
+        if (!key_compare(k, key(before.node)) && !key_compare(key(position.node), k))
+        {
+            if (right(before.node) == 0)
+            {
+                return __insert(0, before.node, v);
+            }
+            return __insert(position.node, position.node, v);
+        }
+    }
+
+    if (position.node != header && !key_compare(k, key(position.node)))
+    {
+        iterator after = position;
+        ++after;
+        if (after.node == header || !key_compare(key(after.node), k))
+        {
+            if (right(position.node) == 0)
+            {
+                return __insert(0, position.node, v);
+            }
+            return __insert(after.node, after.node, v);
+        }
+    }
+    return insert_equal(v);
+}
+
+//뽨һȫƽС1
+//Կֻ㣬һ㣨red_depthĽڵͿ켴
+template <class Key, class Value, class KeyOfValue, class Compare, class Alloc, class NodeUpdate, class Stats>
+template <class InputIterator>
+typename rb_tree<Key, Value, KeyOfValue, Compare, Alloc, NodeUpdate, Stats>::link_type
+rb_tree<Key, Value, KeyOfValue, Compare, Alloc, NodeUpdate, Stats>::__build_sorted(InputIterator& first, size_type n, size_type depth, size_type red_depth, node_batch& batch)
+{
+    if (n == 0)
+    {
+        return 0;
+    }
+
+    size_type left_count = (n - 1) / 2;
+    link_type l = __build_sorted(first, left_count, depth + 1, red_depth, batch);
+    link_type x = construct_node(batch.next(), *first);
+    ++first;
+    link_type r = __build_sorted(first, n - 1 - left_count, depth + 1, red_depth, batch);
+
+    set_color(x, depth == red_depth ? __rb_tree_red : __rb_tree_black);
+    left(x) = l;
+    right(x) = r;
+    if (l != 0)
+    {
+        set_parent(l, x);
+    }
+    if (r != 0)
+    {
+        set_parent(r, x);
+    }
+    NodeUpdate()(x);
+    return x;
+}
+
+template <class Key, class Value, class KeyOfValue, class Compare, class Alloc, class NodeUpdate, class Stats>
+template <class InputIterator>
+void rb_tree<Key, Value, KeyOfValue, Compare, Alloc, NodeUpdate, Stats>::assign_sorted(InputIterator first, size_type n)
+{
+    clear();
+    if (n == 0)
+    {
+        return;
+    }
+
+    //ĲΪfloor(log2(n + 1))һҪͿһ
+    size_type full_levels = 0;
+    for (size_type m = n + 1; m > 1; m >>= 1)
+    {
+        ++full_levels;
+    }
+
+    node_batch batch(n, this);
+    set_root(__build_sorted(first, n, 0, full_levels, batch));
+    set_parent(root(), header);
+    leftmost() = minimum(root());
+    rightmost() = maximum(root());
+    node_count = n;
+}
+
+template <class NodeUpdate>
+inline __rb_tree_node_base* __rb_tree_rebalance_for_erase(__rb_tree_node_base* z,
+    __rb_tree_node_base*& root, __rb_tree_node_base*& leftmost, __rb_tree_node_base*& rightmost,
+    const NodeUpdate& update);
+template <class Key, class Value, class KeyOfValue, class Compare, class Alloc, class NodeUpdate, class Stats>
+void rb_tree<Key, Value, KeyOfValue, Compare, Alloc, NodeUpdate, Stats>::erase(iterator position)
+{
+    base_ptr r = root();
+    link_type y = (link_type)__rb_tree_rebalance_for_erase(position.node, r, header->left, header->right,
+        stats_update(this));
+    header->set_parent(r);
+    destroy_node(y);
+    --node_count;
+}
+
+template <class Key, class Value, class KeyOfValue, class Compare, class Alloc, class NodeUpdate, class Stats>
+typename rb_tree<Key, Value, KeyOfValue, Compare, Alloc, NodeUpdate, Stats>::size_type
+rb_tree<Key, Value, KeyOfValue, Compare, Alloc, NodeUpdate, Stats>::erase(const Key& k)
+{
+    pair<iterator, iterator> p = equal_range(k);
+    size_type n = 0;
+    for (iterator it = p.first; it != p.second; ++it)
+    {
+        ++n;
     }
+    erase(p.first, p.second);
+    return n;
+}
 
-    return __insert(x, y, v);
+
+template <class Key, class Value, class KeyOfValue, class Compare, class Alloc, class NodeUpdate, class Stats>
+void rb_tree<Key, Value, KeyOfValue, Compare, Alloc, NodeUpdate, Stats>::erase(iterator first, iterator last)
+{
+    if (first == begin() && last == end())
+    {
+        clear();
+    }
+    else
+    {
+        while (first != last)
+        {
+            erase(first++);
+        }
+    }
 }
 
-inline void __rb_tree_rebalance(__rb_tree_node_base *x, __rb_tree_node_base* &root);
-//ִвĳ
-template <class Key, class Value, class KeyOfValue, class Compare, class Alloc /*= my_alloc*/>
-typename rb_tree<Key, Value, KeyOfValue, Compare, Alloc>::iterator 
-rb_tree<Key, Value, KeyOfValue, Compare, Alloc>::__insert(base_ptr x_, base_ptr y_, const value_type& v)
+template <class NodeUpdate>
+inline bool __rb_tree_rebalance(__rb_tree_node_base *x, __rb_tree_node_base* &root, const NodeUpdate& update);
+//ִвĳ򣺰ѾֵĽڵzy
+template <class Key, class Value, class KeyOfValue, class Compare, class Alloc, class NodeUpdate, class Stats>
+typename rb_tree<Key, Value, KeyOfValue, Compare, Alloc, NodeUpdate, Stats>::iterator 
+rb_tree<Key, Value, KeyOfValue, Compare, Alloc, NodeUpdate, Stats>::__insert_node(base_ptr x_, base_ptr y_, link_type z)
 {
     link_type x = (link_type)x_;
     link_type y = (link_type)y_;
-    link_type z;
 
-    //TODO:ʲôx!=0
-    if (y == header || x != 0 || key_compare(KeyOfValue()(v), key(y)))
+    //xΪ0ֻڴʾĲУʾ½ڵһy
+    if (y == header || x != 0 || key_compare(key(z), key(y)))
     {
-        z = create_node(v);
         left(y) = z;    //yΪheaderʱʹleftmostָz
         if (y == header)
         {
-            root() = z;
+            set_root(z);
             rightmost() = z;
         }
 
@@ -542,7 +1622,6 @@ rb_tree<Key, Value, KeyOfValue, Compare, Alloc>::__insert(base_ptr x_, base_ptr
     }
     else
     {
-        z = create_node(v);
         right(y) = z;
         if (y == rightmost())
         {
@@ -550,12 +1629,14 @@ rb_tree<Key, Value, KeyOfValue, Compare, Alloc>::__insert(base_ptr x_, base_ptr
         }
     }
 
-    parent(z) = y;
+    set_parent(z, y);
     left(z) = 0;
     right(z) = 0;
 
     //ȷڵɫrb tree
-    __rb_tree_rebalance(z, header->parent);
+    base_ptr r = root();
+    __rb_tree_rebalance(z, r, stats_update(this));
+    header->set_parent(r);
     ++node_count;
     return iterator(z);
 }
@@ -563,124 +1644,1244 @@ rb_tree<Key, Value, KeyOfValue, Compare, Alloc>::__insert(base_ptr x_, base_ptr
 //ȫֺ
 //ƽ
 
-inline void __rb_tree_rotate_left(__rb_tree_node_base *x, __rb_tree_node_base* & root);
-inline void __rb_tree_rotate_right(__rb_tree_node_base *x, __rb_tree_node_base* & root);
-inline void __rb_tree_rebalance(__rb_tree_node_base *x, __rb_tree_node_base* &root)
+template <class NodeUpdate>
+inline void __rb_tree_rotate_left(__rb_tree_node_base *x, __rb_tree_node_base* & root, const NodeUpdate& update);
+template <class NodeUpdate>
+inline void __rb_tree_rotate_right(__rb_tree_node_base *x, __rb_tree_node_base* & root, const NodeUpdate& update);
+//ظǷɺڣĺڸǷ1
+template <class NodeUpdate>
+inline bool __rb_tree_rebalance(__rb_tree_node_base *x, __rb_tree_node_base* &root, const NodeUpdate& update)
 {
-    x->color = __rb_tree_red;
+    //½ڵϺ󣬴·ÿڵĸϢҪ£֮תֻӰֲ
+    if (NodeUpdate::enabled)
+    {
+        for (__rb_tree_node_base* p = x; ; p = p->get_parent())
+        {
+            update(p);
+            if (p == root)
+            {
+                break;
+            }
+        }
+    }
+
+    x->set_color(__rb_tree_red);
     //ڵʹڵ㣬Ҫ
-    while (x != root && x->parent->color == __rb_tree_red)
+    while (x != root && x->get_parent()->get_color() == __rb_tree_red)
     {
         //ڵΪ游ڵڵ
-        if (x->parent == x->parent->parent->left)
+        if (x->get_parent() == x->get_parent()->get_parent()->left)
         {
-            __rb_tree_node_base* y = x->parent->parent->right;  //yΪڵ
-            if (y && y->color == __rb_tree_red) //ڵΪɫ
+            __rb_tree_node_base* y = x->get_parent()->get_parent()->right;  //yΪڵ
+            if (y && y->get_color() == __rb_tree_red) //ڵΪɫ
             {
                 //ڵͲڵΪɫʱ游ڵĺɫӽڵ㣬ʹڽڵȲ䡣Ǵʱ游ڵ˺ɫҪϼ
-                x->parent->color = __rb_tree_black;
-                y->color = __rb_tree_black;
-                x->parent->parent->color = __rb_tree_red;
-                x = x->parent->parent;
+                x->get_parent()->set_color(__rb_tree_black);
+                y->set_color(__rb_tree_black);
+                x->get_parent()->get_parent()->set_color(__rb_tree_red);
+                __rb_tree_note_recolor(update, 3);
+                x = x->get_parent()->get_parent();
             }
             else
             {
                 //޲ڵ߲ڵΪɫ
-                if (x == x->parent->right)
+                if (x == x->get_parent()->right)
                 {
                     //ڵǸڵҽڵ㣬Ÿڵת
-                    x = x->parent;
-                    __rb_tree_rotate_left(x, root);
+                    x = x->get_parent();
+                    __rb_tree_rotate_left(x, root, update);
                 }
 
-                x->parent->color = __rb_tree_black;
-                x->parent->parent->color = __rb_tree_red;
-                __rb_tree_rotate_right(x->parent->parent, root);
+                x->get_parent()->set_color(__rb_tree_black);
+                x->get_parent()->get_parent()->set_color(__rb_tree_red);
+                __rb_tree_note_recolor(update, 2);
+                __rb_tree_rotate_right(x->get_parent()->get_parent(), root, update);
             }
         }
         else  //ڵΪ游ڵӽڵ
         {
-            __rb_tree_node_base *y = x->parent->parent->left;
-            if (y && y->color == __rb_tree_red) //ڵΪɫ
+            __rb_tree_node_base *y = x->get_parent()->get_parent()->left;
+            if (y && y->get_color() == __rb_tree_red) //ڵΪɫ
             {
                 //ڵͲڵΪɫʱ游ڵĺɫӽڵ㣬ʹڽڵȲ䡣Ǵʱ游ڵ˺ɫҪϼ
-                x->parent->color = __rb_tree_black;
-                y->color = __rb_tree_black;
-                x->parent->parent->color = __rb_tree_red;
-                x = x->parent->parent;
+                x->get_parent()->set_color(__rb_tree_black);
+                y->set_color(__rb_tree_black);
+                x->get_parent()->get_parent()->set_color(__rb_tree_red);
+                __rb_tree_note_recolor(update, 3);
+                x = x->get_parent()->get_parent();
             }
             else
             {
                 //޲ڵ߲ڵΪɫ
-                if (x == x->parent->left)
+                if (x == x->get_parent()->left)
                 {
                     //ڵǸڵڵ㣬Ÿڵתұ
-                    x = x->parent;
-                    __rb_tree_rotate_right(x, root);
+                    x = x->get_parent();
+                    __rb_tree_rotate_right(x, root, update);
                 }
 
-                x->parent->color = __rb_tree_black;
-                x->parent->parent->color = __rb_tree_red;
-                __rb_tree_rotate_left(x->parent->parent, root);
+                x->get_parent()->set_color(__rb_tree_black);
+                x->get_parent()->get_parent()->set_color(__rb_tree_red);
+                __rb_tree_note_recolor(update, 2);
+                __rb_tree_rotate_left(x->get_parent()->get_parent(), root, update);
             }
         }
     }
 
-    root->color = __rb_tree_black;
+    bool grew = root->get_color() == __rb_tree_red;
+    root->set_color(__rb_tree_black);
+    return grew;
 }
 
-inline void __rb_tree_rotate_left(__rb_tree_node_base *x, __rb_tree_node_base* & root)
+//ɾڵzƽ⣬ҪͷŵĽڵ
+//zӽڵʱĺyzλúɫժyԭλ
+template <class NodeUpdate>
+inline __rb_tree_node_base* __rb_tree_rebalance_for_erase(__rb_tree_node_base* z,
+    __rb_tree_node_base*& root, __rb_tree_node_base*& leftmost, __rb_tree_node_base*& rightmost,
+    const NodeUpdate& update)
 {
-    __rb_tree_node_base *y = x->right;
-    x->right = y->left;
-    if (y->left != 0)
-    {
-        y->left->parent = x;
-    }
-    y->parent = x->parent;
-    if (x == root)
+    __rb_tree_node_base* y = z;
+    __rb_tree_node_base* x = 0;         //汻ժλõĽڵ㣬Ϊ
+    __rb_tree_node_base* x_parent = 0;  //xΪʱϵ
+
+    if (y->left == 0)
     {
-        root = y;
+        x = y->right;
     }
-    else if (x == x->parent->left)
+    else if (y->right == 0)
     {
-        x->parent->left = y;
+        x = y->left;
     }
     else
     {
-        x->parent->right = y;
+        //ӽڵ㣬yȡڵ㣨̣
+        y = y->right;
+        while (y->left != 0)
+        {
+            y = y->left;
+        }
+        x = y->right;
     }
 
-    y->left = x;
-    x->parent = y;
-}
-
-inline void __rb_tree_rotate_right(__rb_tree_node_base *x, __rb_tree_node_base* & root)
-{
-    __rb_tree_node_base *y = x->left;
-    x->left = y->right;
-    if (y->right != 0)
+    if (y != z)
     {
-        y->right->parent = x;
-    }
-    y->parent = x->parent;
-    if (x == root)
-    {
-        root = y;
-    }
-    else if (x == x->parent->right)
-    {
-        x->parent->right = y;
-    }
-    else
+        //yz
+        z->left->set_parent(y);
+        y->left = z->left;
+        if (y != z->right)
+        {
+            x_parent = y->get_parent();
+            if (x)
+            {
+                x->set_parent(y->get_parent());
+            }
+            y->get_parent()->left = x;
+            y->right = z->right;
+            z->right->set_parent(y);
+        }
+        else
+        {
+            x_parent = y;
+        }
+
+        if (root == z)
+        {
+            root = y;
+        }
+        else if (z->get_parent()->left == z)
+        {
+            z->get_parent()->left = y;
+        }
+        else
+        {
+            z->get_parent()->right = y;
+        }
+        y->set_parent(z->get_parent());
+        __rb_tree_color_type c = y->get_color();
+        y->set_color(z->get_color());
+        z->set_color(c);
+        y = z;      //yָҪͷŵĽڵ
+    }
+    else
+    {
+        //zһӽڵ㣬ֱӽڵx
+        x_parent = y->get_parent();
+        if (x)
+        {
+            x->set_parent(y->get_parent());
+        }
+
+        if (root == z)
+        {
+            root = x;
+        }
+        else if (z->get_parent()->left == z)
+        {
+            z->get_parent()->left = x;
+        }
+        else
+        {
+            z->get_parent()->right = x;
+        }
+
+        if (leftmost == z)
+        {
+            //zûӽڵ㣬µСֵСֵ߸ڵ
+            leftmost = z->right == 0 ? z->get_parent() : __rb_tree_node_base::minimum(x);
+        }
+        if (rightmost == z)
+        {
+            rightmost = z->left == 0 ? z->get_parent() : __rb_tree_node_base::maximum(x);
+        }
+    }
+
+    //ӱժλõĸڵ㵽ϢҪ
+    //ֻɾֻһӽڵĸʱx_parentheaderʱҪ
+    if (NodeUpdate::enabled && root != 0 && x_parent != root->get_parent())
+    {
+        for (__rb_tree_node_base* p = x_parent; ; p = p->get_parent())
+        {
+            update(p);
+            if (p == root)
+            {
+                break;
+            }
+        }
+    }
+
+    //ժǺڽڵʱx·һڽڵ㣬Ҫ
+    if (y->get_color() != __rb_tree_red)
+    {
+        while (x != root && (x == 0 || x->get_color() == __rb_tree_black))
+        {
+            if (x == x_parent->left)
+            {
+                __rb_tree_node_base* w = x_parent->right;   //wΪֵܽڵ
+                if (w->get_color() == __rb_tree_red)
+                {
+                    //ֵΪɫתתΪֵΪɫ
+                    w->set_color(__rb_tree_black);
+                    x_parent->set_color(__rb_tree_red);
+                    __rb_tree_note_recolor(update, 2);
+                    __rb_tree_rotate_left(x_parent, root, update);
+                    w = x_parent->right;
+                }
+
+                if ((w->left == 0 || w->left->get_color() == __rb_tree_black) &&
+                    (w->right == 0 || w->right->get_color() == __rb_tree_black))
+                {
+                    //ֵܵӽڵ㶼ǺɫֵͿ죬ȱٵĺɫڵϴ
+                    w->set_color(__rb_tree_red);
+                    __rb_tree_note_recolor(update, 1);
+                    x = x_parent;
+                    x_parent = x_parent->get_parent();
+                }
+                else
+                {
+                    if (w->right == 0 || w->right->get_color() == __rb_tree_black)
+                    {
+                        //ֵܵĽֶΪ죬ԶֶΪڣֵתΪԶֶΪ
+                        if (w->left)
+                        {
+                            w->left->set_color(__rb_tree_black);
+                        }
+                        w->set_color(__rb_tree_red);
+                        __rb_tree_note_recolor(update, 2);
+                        __rb_tree_rotate_right(w, root, update);
+                        w = x_parent->right;
+                    }
+                    //ԶֶΪ죬ڵһڽڵ㣬
+                    w->set_color(x_parent->get_color());
+                    x_parent->set_color(__rb_tree_black);
+                    if (w->right)
+                    {
+                        w->right->set_color(__rb_tree_black);
+                    }
+                    __rb_tree_note_recolor(update, 3);
+                    __rb_tree_rotate_left(x_parent, root, update);
+                    break;
+                }
+            }
+            else    //xΪӽڵ㣬Գ
+            {
+                __rb_tree_node_base* w = x_parent->left;
+                if (w->get_color() == __rb_tree_red)
+                {
+                    w->set_color(__rb_tree_black);
+                    x_parent->set_color(__rb_tree_red);
+                    __rb_tree_note_recolor(update, 2);
+                    __rb_tree_rotate_right(x_parent, root, update);
+                    w = x_parent->left;
+                }
+
+                if ((w->right == 0 || w->right->get_color() == __rb_tree_black) &&
+                    (w->left == 0 || w->left->get_color() == __rb_tree_black))
+                {
+                    w->set_color(__rb_tree_red);
+                    __rb_tree_note_recolor(update, 1);
+                    x = x_parent;
+                    x_parent = x_parent->get_parent();
+                }
+                else
+                {
+                    if (w->left == 0 || w->left->get_color() == __rb_tree_black)
+                    {
+                        if (w->right)
+                        {
+                            w->right->set_color(__rb_tree_black);
+                        }
+                        w->set_color(__rb_tree_red);
+                        __rb_tree_note_recolor(update, 2);
+                        __rb_tree_rotate_left(w, root, update);
+                        w = x_parent->left;
+                    }
+                    w->set_color(x_parent->get_color());
+                    x_parent->set_color(__rb_tree_black);
+                    if (w->left)
+                    {
+                        w->left->set_color(__rb_tree_black);
+                    }
+                    __rb_tree_note_recolor(update, 3);
+                    __rb_tree_rotate_right(x_parent, root, update);
+                    break;
+                }
+            }
+        }
+        if (x)
+        {
+            x->set_color(__rb_tree_black);
+        }
+    }
+    return y;
+}
+
+template <class NodeUpdate>
+inline void __rb_tree_rotate_left(__rb_tree_node_base *x, __rb_tree_node_base* & root, const NodeUpdate& update)
+{
+    __rb_tree_node_base *y = x->right;
+    x->right = y->left;
+    if (y->left != 0)
+    {
+        y->left->set_parent(x);
+    }
+    y->set_parent(x->get_parent());
+    if (x == root)
+    {
+        root = y;
+    }
+    else if (x == x->get_parent()->left)
+    {
+        x->get_parent()->left = y;
+    }
+    else
+    {
+        x->get_parent()->right = y;
+    }
+
+    y->left = x;
+    x->set_parent(y);
+
+    //xΪyӽڵ㣬ȸxٸy
+    update(x);
+    update(y);
+    __rb_tree_note_rotation(update);
+}
+
+template <class NodeUpdate>
+inline void __rb_tree_rotate_right(__rb_tree_node_base *x, __rb_tree_node_base* & root, const NodeUpdate& update)
+{
+    __rb_tree_node_base *y = x->left;
+    x->left = y->right;
+    if (y->right != 0)
+    {
+        y->right->set_parent(x);
+    }
+    y->set_parent(x->get_parent());
+    if (x == root)
+    {
+        root = y;
+    }
+    else if (x == x->get_parent()->right)
+    {
+        x->get_parent()->right = y;
+    }
+    else
     {
-        x->parent->left = y;
+        x->get_parent()->left = y;
     }
 
     y->right = x;
-    x->parent = y;
+    x->set_parent(y);
+
+    update(x);
+    update(y);
+    __rb_tree_note_rotation(update);
+}
+
+//xΪڸparent_bhĽڵӽڵ㣬ȡºΪxΪɫʱͿڣڸ߱ȸڵС1ĹͲ
+template <class Key, class Value, class KeyOfValue, class Compare, class Alloc, class NodeUpdate, class Stats>
+typename rb_tree<Key, Value, KeyOfValue, Compare, Alloc, NodeUpdate, Stats>::subtree
+rb_tree<Key, Value, KeyOfValue, Compare, Alloc, NodeUpdate, Stats>::expose_child(base_ptr x, size_type parent_bh)
+{
+    if (x == 0)
+    {
+        return make_subtree(0, 0);
+    }
+    x->set_parent(0);
+    if (x->get_color() == __rb_tree_red)
+    {
+        x->set_color(__rb_tree_black);
+        return make_subtree(x, parent_bh);
+    }
+    return make_subtree(x, parent_bh - 1);
+}
+
+//Ϊȡ*thisΪ
+template <class Key, class Value, class KeyOfValue, class Compare, class Alloc, class NodeUpdate, class Stats>
+typename rb_tree<Key, Value, KeyOfValue, Compare, Alloc, NodeUpdate, Stats>::subtree
+rb_tree<Key, Value, KeyOfValue, Compare, Alloc, NodeUpdate, Stats>::release_root()
+{
+    base_ptr x = root();
+    size_type bh = 0;
+    for (base_ptr y = x; y != 0; y = y->left)
+    {
+        bh += y->get_color() == __rb_tree_black;
+    }
+    if (x != 0)
+    {
+        x->set_parent(0);
+    }
+    set_root(0);
+    leftmost() = header;
+    rightmost() = header;
+    node_count = 0;
+    return make_subtree(x, bh);
+}
+
+//tΪ
+template <class Key, class Value, class KeyOfValue, class Compare, class Alloc, class NodeUpdate, class Stats>
+void rb_tree<Key, Value, KeyOfValue, Compare, Alloc, NodeUpdate, Stats>::adopt_root(subtree t, size_type n)
+{
+    set_root((link_type)t.root);
+    if (t.root != 0)
+    {
+        set_parent(t.root, header);
+        leftmost() = minimum(root());
+        rightmost() = maximum(root());
+    }
+    else
+    {
+        leftmost() = header;
+        rightmost() = header;
+    }
+    node_count = n;
+}
+
+//ԽڵkΪָlrlеļk֮ǰrеļk֮
+//ڸ߽ϴһڲļ½ڸһȵĺڽڵykȡyyһΪkӽڵ㣬
+//ٰk²ĺڵ޸ΪO(ߺڸ֮ + 1)
+template <class Key, class Value, class KeyOfValue, class Compare, class Alloc, class NodeUpdate, class Stats>
+typename rb_tree<Key, Value, KeyOfValue, Compare, Alloc, NodeUpdate, Stats>::subtree
+rb_tree<Key, Value, KeyOfValue, Compare, Alloc, NodeUpdate, Stats>::__join(subtree l, base_ptr k, subtree r) const
+{
+    if (l.bh == r.bh)
+    {
+        k->left = l.root;
+        k->right = r.root;
+        k->set_parent(0);
+        k->set_color(__rb_tree_black);
+        if (l.root != 0)
+        {
+            l.root->set_parent(k);
+        }
+        if (r.root != 0)
+        {
+            r.root->set_parent(k);
+        }
+        NodeUpdate()(k);
+        return make_subtree(k, l.bh + 1);
+    }
+
+    base_ptr root;
+    if (l.bh > r.bh)
+    {
+        base_ptr p = 0;
+        base_ptr y = l.root;
+        size_type h = l.bh;
+        while (y != 0 && !(y->get_color() == __rb_tree_black && h == r.bh))
+        {
+            h -= y->get_color() == __rb_tree_black;
+            p = y;
+            y = y->right;
+        }
+        k->left = y;
+        k->right = r.root;
+        p->right = k;
+        k->set_parent(p);
+        root = l.root;
+    }
+    else
+    {
+        base_ptr p = 0;
+        base_ptr y = r.root;
+        size_type h = r.bh;
+        while (y != 0 && !(y->get_color() == __rb_tree_black && h == l.bh))
+        {
+            h -= y->get_color() == __rb_tree_black;
+            p = y;
+            y = y->left;
+        }
+        k->left = l.root;
+        k->right = y;
+        p->left = k;
+        k->set_parent(p);
+        root = r.root;
+    }
+    if (k->left != 0)
+    {
+        k->left->set_parent(k);
+    }
+    if (k->right != 0)
+    {
+        k->right->set_parent(k);
+    }
+    size_type bh = l.bh > r.bh ? l.bh : r.bh;
+    if (__rb_tree_rebalance(k, root, stats_update(this)))
+    {
+        ++bh;
+    }
+    return make_subtree(root, bh);
+}
+
+//ûзָڵӣȴlȡĽڵΪָ
+template <class Key, class Value, class KeyOfValue, class Compare, class Alloc, class NodeUpdate, class Stats>
+typename rb_tree<Key, Value, KeyOfValue, Compare, Alloc, NodeUpdate, Stats>::subtree
+rb_tree<Key, Value, KeyOfValue, Compare, Alloc, NodeUpdate, Stats>::__join2(subtree l, subtree r) const
+{
+    if (l.root == 0)
+    {
+        return r;
+    }
+    if (r.root == 0)
+    {
+        return l;
+    }
+    base_ptr m;
+    __split_last(l, l, m);
+    return __join(l, m, r);
+}
+
+//tֳɼk֮ǰlkĽڵmûʱΪ0ͼk֮r
+//ز·½ʱ·ϵĽڵ㵱ָӣӵĴ֮ΪO(log n)
+template <class Key, class Value, class KeyOfValue, class Compare, class Alloc, class NodeUpdate, class Stats>
+void rb_tree<Key, Value, KeyOfValue, Compare, Alloc, NodeUpdate, Stats>::__split(subtree t, const Key& k, subtree& l, base_ptr& m, subtree& r) const
+{
+    if (t.root == 0)
+    {
+        l = r = make_subtree(0, 0);
+        m = 0;
+        return;
+    }
+    base_ptr x = t.root;
+    subtree xl = expose_child(x->left, t.bh);
+    subtree xr = expose_child(x->right, t.bh);
+    this->count_visit();
+    this->count_compare();
+    if (key_compare(k, key(x)))
+    {
+        subtree rl;
+        __split(xl, k, l, m, rl);
+        r = __join(rl, x, xr);
+        return;
+    }
+    this->count_compare();
+    if (key_compare(key(x), k))
+    {
+        subtree lr;
+        __split(xr, k, lr, m, r);
+        l = __join(xl, x, lr);
+    }
+    else
+    {
+        l = xl;
+        m = x;
+        r = xr;
+    }
+}
+
+//tֳɼСklrkĽڵ㲻мr
+template <class Key, class Value, class KeyOfValue, class Compare, class Alloc, class NodeUpdate, class Stats>
+void rb_tree<Key, Value, KeyOfValue, Compare, Alloc, NodeUpdate, Stats>::__split_lower(subtree t, const Key& k, subtree& l, subtree& r) const
+{
+    if (t.root == 0)
+    {
+        l = r = make_subtree(0, 0);
+        return;
+    }
+    base_ptr x = t.root;
+    subtree xl = expose_child(x->left, t.bh);
+    subtree xr = expose_child(x->right, t.bh);
+    this->count_visit();
+    this->count_compare();
+    if (key_compare(key(x), k))
+    {
+        subtree lr;
+        __split_lower(xr, k, lr, r);
+        l = __join(xl, x, lr);
+    }
+    else
+    {
+        subtree rl;
+        __split_lower(xl, k, l, rl);
+        r = __join(rl, x, xr);
+    }
+}
+
+//ȡtĽڵmڵl
+template <class Key, class Value, class KeyOfValue, class Compare, class Alloc, class NodeUpdate, class Stats>
+void rb_tree<Key, Value, KeyOfValue, Compare, Alloc, NodeUpdate, Stats>::__split_last(subtree t, subtree& l, base_ptr& m) const
+{
+    base_ptr x = t.root;
+    subtree xl = expose_child(x->left, t.bh);
+    if (x->right == 0)
+    {
+        l = xl;
+        m = x;
+        return;
+    }
+    subtree xr = expose_child(x->right, t.bh);
+    subtree rl;
+    __split_last(xr, rl, m);
+    l = __join(xl, x, rl);
 }
 
+//ڵ̣߳d2^d߳ͬʱ
+template <class Key, class Value, class KeyOfValue, class Compare, class Alloc, class NodeUpdate, class Stats>
+typename rb_tree<Key, Value, KeyOfValue, Compare, Alloc, NodeUpdate, Stats>::size_type
+rb_tree<Key, Value, KeyOfValue, Compare, Alloc, NodeUpdate, Stats>::parallel_depth(size_type n)
+{
+    if (n < size_type(parallel_threshold))
+    {
+        return 0;
+    }
+    size_type depth = 0;
+    for (size_type threads = std::thread::hardware_concurrency(); threads > 1; threads >>= 1)
+    {
+        ++depth;
+    }
+    return depth;
+}
+
+//ͷжĽڵ㣬ظһ̰߳ȫģֻڵ߳ͷ
+template <class Key, class Value, class KeyOfValue, class Compare, class Alloc, class NodeUpdate, class Stats>
+typename rb_tree<Key, Value, KeyOfValue, Compare, Alloc, NodeUpdate, Stats>::size_type
+rb_tree<Key, Value, KeyOfValue, Compare, Alloc, NodeUpdate, Stats>::free_list(node_list& garbage)
+{
+    size_type n = 0;
+    for (base_ptr x = garbage.head; x != 0; ++n)
+    {
+        base_ptr next = x->right;
+        destroy_node((link_type)x);
+        x = next;
+    }
+    return n;
+}
+
+//aĸΪָbֱݹ󲢼ӣ߶еļbеĽڵ
+template <class Key, class Value, class KeyOfValue, class Compare, class Alloc, class NodeUpdate, class Stats>
+typename rb_tree<Key, Value, KeyOfValue, Compare, Alloc, NodeUpdate, Stats>::subtree
+rb_tree<Key, Value, KeyOfValue, Compare, Alloc, NodeUpdate, Stats>::__union(subtree a, subtree b, node_list& garbage, size_type par_depth) const
+{
+    if (a.root == 0)
+    {
+        return b;
+    }
+    if (b.root == 0)
+    {
+        return a;
+    }
+    base_ptr x = a.root;
+    subtree al = expose_child(x->left, a.bh);
+    subtree ar = expose_child(x->right, a.bh);
+    subtree bl, br;
+    base_ptr m;
+    this->count_descent();
+    __split(b, key(x), bl, m, br);
+    if (m != 0)
+    {
+        garbage.push(m);
+    }
 
+    subtree l, r;
+    if (par_depth > 0)
+    {
+        node_list left_garbage;
+        std::thread worker([&]() { l = __union(al, bl, left_garbage, par_depth - 1); });
+        r = __union(ar, br, garbage, par_depth - 1);
+        worker.join();
+        garbage.splice(left_garbage);
+    }
+    else
+    {
+        l = __union(al, bl, garbage, 0);
+        r = __union(ar, br, garbage, 0);
+    }
+    return __join(l, x, r);
+}
+
+template <class Key, class Value, class KeyOfValue, class Compare, class Alloc, class NodeUpdate, class Stats>
+typename rb_tree<Key, Value, KeyOfValue, Compare, Alloc, NodeUpdate, Stats>::subtree
+rb_tree<Key, Value, KeyOfValue, Compare, Alloc, NodeUpdate, Stats>::__intersect(subtree a, subtree b, node_list& garbage, size_type par_depth) const
+{
+    if (a.root == 0 || b.root == 0)
+    {
+        garbage.push_subtree(a.root);
+        garbage.push_subtree(b.root);
+        return make_subtree(0, 0);
+    }
+    base_ptr x = a.root;
+    subtree al = expose_child(x->left, a.bh);
+    subtree ar = expose_child(x->right, a.bh);
+    subtree bl, br;
+    base_ptr m;
+    this->count_descent();
+    __split(b, key(x), bl, m, br);
+
+    subtree l, r;
+    if (par_depth > 0)
+    {
+        node_list left_garbage;
+        std::thread worker([&]() { l = __intersect(al, bl, left_garbage, par_depth - 1); });
+        r = __intersect(ar, br, garbage, par_depth - 1);
+        worker.join();
+        garbage.splice(left_garbage);
+    }
+    else
+    {
+        l = __intersect(al, bl, garbage, 0);
+        r = __intersect(ar, br, garbage, 0);
+    }
+    if (m != 0)
+    {
+        garbage.push(m);
+        return __join(l, x, r);
+    }
+    garbage.push(x);
+    return __join2(l, r);
+}
+
+template <class Key, class Value, class KeyOfValue, class Compare, class Alloc, class NodeUpdate, class Stats>
+typename rb_tree<Key, Value, KeyOfValue, Compare, Alloc, NodeUpdate, Stats>::subtree
+rb_tree<Key, Value, KeyOfValue, Compare, Alloc, NodeUpdate, Stats>::__difference(subtree a, subtree b, node_list& garbage, size_type par_depth) const
+{
+    if (a.root == 0 || b.root == 0)
+    {
+        garbage.push_subtree(b.root);
+        return a;
+    }
+    base_ptr x = a.root;
+    subtree al = expose_child(x->left, a.bh);
+    subtree ar = expose_child(x->right, a.bh);
+    subtree bl, br;
+    base_ptr m;
+    this->count_descent();
+    __split(b, key(x), bl, m, br);
+
+    subtree l, r;
+    if (par_depth > 0)
+    {
+        node_list left_garbage;
+        std::thread worker([&]() { l = __difference(al, bl, left_garbage, par_depth - 1); });
+        r = __difference(ar, br, garbage, par_depth - 1);
+        worker.join();
+        garbage.splice(left_garbage);
+    }
+    else
+    {
+        l = __difference(al, bl, garbage, 0);
+        r = __difference(ar, br, garbage, 0);
+    }
+    if (m != 0)
+    {
+        garbage.push(m);
+        garbage.push(x);
+        return __join2(l, r);
+    }
+    return __join(l, x, r);
+}
+
+//ڵСʱߵĽڵֱӴӸ϶ͬʱͷСһͣO(min(, ))
+//ڵеĽڵ㲻ᶯright*thisͬ*thisеڴ
+template <class Key, class Value, class KeyOfValue, class Compare, class Alloc, class NodeUpdate, class Stats>
+void rb_tree<Key, Value, KeyOfValue, Compare, Alloc, NodeUpdate, Stats>::split(const Key& k, rb_tree& right)
+{
+    typedef __rb_tree_subtree_count<NodeUpdate> subtree_count;
+    if (&right == this)
+    {
+        std::cerr << "rb_tree::split: right must be another tree" << std::endl;
+        exit(1);
+    }
+    right.clear();
+    size_type n = node_count;
+    subtree l, r;
+    this->count_descent();
+    __split_lower(release_root(), k, l, r);
+    if (r.root != 0)
+    {
+        this->share_nodes(right);
+    }
+    adopt_root(l, 0);
+    right.adopt_root(r, 0);
+
+    if (subtree_count::known)
+    {
+        node_count = subtree_count::count(l.root);
+    }
+    else
+    {
+        iterator i = begin();
+        iterator j = right.begin();
+        size_type count = 0;
+        while (i != end() && j != right.end())
+        {
+            ++i;
+            ++j;
+            ++count;
+        }
+        node_count = i == end() ? count : n - count;
+    }
+    right.node_count = n - node_count;
+}
+
+template <class Key, class Value, class KeyOfValue, class Compare, class Alloc, class NodeUpdate, class Stats>
+void rb_tree<Key, Value, KeyOfValue, Compare, Alloc, NodeUpdate, Stats>::join(rb_tree& right)
+{
+    if (&right == this)
+    {
+        return;
+    }
+    size_type n = node_count + right.node_count;
+    this->splice_nodes(right);
+    subtree l = release_root();
+    subtree r = right.release_root();
+    adopt_root(__join2(l, r), n);
+}
+
+template <class Key, class Value, class KeyOfValue, class Compare, class Alloc, class NodeUpdate, class Stats>
+void rb_tree<Key, Value, KeyOfValue, Compare, Alloc, NodeUpdate, Stats>::union_with(rb_tree& x)
+{
+    if (&x == this)
+    {
+        return;
+    }
+    size_type n = node_count + x.node_count;
+    this->splice_nodes(x);
+    node_list garbage;
+    subtree a = release_root();
+    subtree b = x.release_root();
+    size_type par_depth = Stats::enabled ? 0 : parallel_depth(n);
+    subtree t = __union(a, b, garbage, par_depth);
+    adopt_root(t, n - free_list(garbage));
+}
+
+template <class Key, class Value, class KeyOfValue, class Compare, class Alloc, class NodeUpdate, class Stats>
+void rb_tree<Key, Value, KeyOfValue, Compare, Alloc, NodeUpdate, Stats>::intersect_with(rb_tree& x)
+{
+    if (&x == this)
+    {
+        return;
+    }
+    size_type n = node_count + x.node_count;
+    this->splice_nodes(x);
+    node_list garbage;
+    subtree a = release_root();
+    subtree b = x.release_root();
+    size_type par_depth = Stats::enabled ? 0 : parallel_depth(n);
+    subtree t = __intersect(a, b, garbage, par_depth);
+    adopt_root(t, n - free_list(garbage));
+}
+
+template <class Key, class Value, class KeyOfValue, class Compare, class Alloc, class NodeUpdate, class Stats>
+void rb_tree<Key, Value, KeyOfValue, Compare, Alloc, NodeUpdate, Stats>::difference_with(rb_tree& x)
+{
+    if (&x == this)
+    {
+        clear();
+        return;
+    }
+    size_type n = node_count + x.node_count;
+    this->splice_nodes(x);
+    node_list garbage;
+    subtree a = release_root();
+    subtree b = x.release_root();
+    size_type par_depth = Stats::enabled ? 0 : parallel_depth(n);
+    subtree t = __difference(a, b, garbage, par_depth);
+    adopt_root(t, n - free_list(garbage));
+}
+
+template <class Key, class Value, class KeyOfValue, class Compare, class Alloc, class NodeUpdate, class Stats>
+rb_tree<Key, Value, KeyOfValue, Compare, Alloc, NodeUpdate, Stats>&
+rb_tree<Key, Value, KeyOfValue, Compare, Alloc, NodeUpdate, Stats>::operator=(const rb_tree<Key, Value, KeyOfValue, Compare, Alloc, NodeUpdate, Stats>& x)
+{
+    if (this != &x)
+    {
+        clear();
+        key_compare = x.key_compare;
+        if (x.root() != 0)
+        {
+            node_count = x.size();
+            set_root(__copy(x.root(), header, node_count));
+            leftmost() = minimum(root());
+            rightmost() = maximum(root());
+        }
+    }
+    return *this;
+}
+
+//nڵxĸpΪڵ
+//ڵȫڵ߳úãһ̰߳ȫģڵܶʱ̸ཻͬ߳
+//ֵĸƹmy_allocҪڴ棬Ҳ׳쳣ֻƽƵֵ߳и
+template <class Key, class Value, class KeyOfValue, class Compare, class Alloc, class NodeUpdate, class Stats>
+typename rb_tree<Key, Value, KeyOfValue, Compare, Alloc, NodeUpdate, Stats>::link_type
+rb_tree<Key, Value, KeyOfValue, Compare, Alloc, NodeUpdate, Stats>::__copy(link_type x, link_type p, size_type n)
+{
+    size_type par_depth = is_trivially_copy_constructible<value_type>::value ? parallel_depth(n) : 0;
+    if (par_depth == 0)
+    {
+        node_batch batch(n, this);
+        return __copy_subtree(x, p, batch);
+    }
+
+    //ÿ߳ȡһοò꣬߳ü
+    clone_pool pool;
+    pool.total = n + (size_type(1) << par_depth) * size_type(clone_pool::chunk_size);
+    pool.nodes = link_allocator::allocate(pool.total);
+    this->allocate_nodes(pool.nodes, pool.total);
+    pool.claimed = 0;
+
+    clone_cursor cursor(&pool);
+    link_type top = __copy_parallel(x, p, cursor, par_depth);
+
+    for (size_type i = 0; i < pool.total; ++i)
+    {
+        if (pool.nodes[i] != 0)
+        {
+            put_node(pool.nodes[i]);
+        }
+    }
+    link_allocator::deallocate(pool.nodes, pool.total);
+    return top;
+}
+
+//nodesȡڵ㸴xΪϢӽڵ㶼ƺúټ
+template <class Key, class Value, class KeyOfValue, class Compare, class Alloc, class NodeUpdate, class Stats>
+template <class NodeSource>
+typename rb_tree<Key, Value, KeyOfValue, Compare, Alloc, NodeUpdate, Stats>::link_type
+rb_tree<Key, Value, KeyOfValue, Compare, Alloc, NodeUpdate, Stats>::__copy_subtree(link_type x, link_type p, NodeSource& nodes)
+{
+    link_type top = clone_node(x, nodes.next());
+    set_parent(top, p);
+    if (x->right != 0)
+    {
+        right(top) = __copy_subtree(right(x), top, nodes);
+    }
+    if (x->left != 0)
+    {
+        left(top) = __copy_subtree(left(x), top, nodes);
+    }
+    NodeUpdate()(top);
+    return top;
+}
+
+//̣߳ڵǰ߳иƣpar_depth
+template <class Key, class Value, class KeyOfValue, class Compare, class Alloc, class NodeUpdate, class Stats>
+typename rb_tree<Key, Value, KeyOfValue, Compare, Alloc, NodeUpdate, Stats>::link_type
+rb_tree<Key, Value, KeyOfValue, Compare, Alloc, NodeUpdate, Stats>::__copy_parallel(link_type x, link_type p, clone_cursor& nodes, size_type par_depth)
+{
+    if (par_depth == 0)
+    {
+        return __copy_subtree(x, p, nodes);
+    }
+    link_type top = clone_node(x, nodes.next());
+    set_parent(top, p);
+
+    link_type l = 0;
+    clone_cursor left_nodes(nodes.pool);
+    std::thread worker;
+    if (x->left != 0)
+    {
+        worker = std::thread([&]() { l = __copy_parallel(left(x), top, left_nodes, par_depth - 1); });
+    }
+    if (x->right != 0)
+    {
+        right(top) = __copy_parallel(right(x), top, nodes, par_depth - 1);
+    }
+    if (worker.joinable())
+    {
+        worker.join();
+    }
+    left(top) = l;
+    NodeUpdate()(top);
+    return top;
+}
+
+//nһ__lower_bound½ͬȫߵӺжǷȣҲĽΪheader
+template <class Key, class Value, class KeyOfValue, class Compare, class Alloc, class NodeUpdate, class Stats>
+template <class RandomAccessIterator>
+void rb_tree<Key, Value, KeyOfValue, Compare, Alloc, NodeUpdate, Stats>::__find_group(RandomAccessIterator keys, size_type n, link_type* result) const
+{
+    link_type x[find_batch_width];
+    for (size_type i = 0; i < n; ++i)
+    {
+        result[i] = header;
+        x[i] = root();
+    }
+
+    bool active = root() != 0;
+    while (active)
+    {
+        active = false;
+        for (size_type i = 0; i < n; ++i)
+        {
+            link_type cur = x[i];
+            if (cur == 0)
+            {
+                continue;
+            }
+            if (!key_compare(key(cur), keys[i]))
+            {
+                result[i] = cur;
+                cur = left(cur);
+            }
+            else
+            {
+                cur = right(cur);
+            }
+            __rb_tree_prefetch(cur);
+            x[i] = cur;
+            active = active || cur != 0;
+        }
+    }
+
+    for (size_type i = 0; i < n; ++i)
+    {
+        if (result[i] != header && key_compare(keys[i], key(result[i])))
+        {
+            result[i] = header;
+        }
+    }
+}
+
+template <class Key, class Value, class KeyOfValue, class Compare, class Alloc, class NodeUpdate, class Stats>
+typename rb_tree<Key, Value, KeyOfValue, Compare, Alloc, NodeUpdate, Stats>::size_type
+rb_tree<Key, Value, KeyOfValue, Compare, Alloc, NodeUpdate, Stats>::__height(base_ptr x)
+{
+    if (x == 0)
+    {
+        return 0;
+    }
+    size_type l = __height(x->left);
+    size_type r = __height(x->right);
+    return 1 + (l > r ? l : r);
+}
+
+//xΪĺڸߣʱ-1
+template <class Key, class Value, class KeyOfValue, class Compare, class Alloc, class NodeUpdate, class Stats>
+int rb_tree<Key, Value, KeyOfValue, Compare, Alloc, NodeUpdate, Stats>::__verify_subtree(base_ptr x, const Compare& comp)
+{
+    if (x == 0)
+    {
+        return 0;
+    }
+    base_ptr l = x->left;
+    base_ptr r = x->right;
+    //ڵӽڵǺɫ
+    if (x->get_color() == __rb_tree_red &&
+        ((l != 0 && l->get_color() == __rb_tree_red) || (r != 0 && r->get_color() == __rb_tree_red)))
+    {
+        return -1;
+    }
+    if ((l != 0 && (l->get_parent() != x || comp(key(x), key(l)))) ||
+        (r != 0 && (r->get_parent() != x || comp(key(r), key(x)))))
+    {
+        return -1;
+    }
+    int lh = __verify_subtree(l, comp);
+    int rh = __verify_subtree(r, comp);
+    if (lh < 0 || rh < 0 || lh != rh)
+    {
+        return -1;
+    }
+    return lh + (x->get_color() == __rb_tree_black);
+}
+
+template <class Key, class Value, class KeyOfValue, class Compare, class Alloc, class NodeUpdate, class Stats>
+bool rb_tree<Key, Value, KeyOfValue, Compare, Alloc, NodeUpdate, Stats>::__rb_verify() const
+{
+    if (root() == 0)
+    {
+        return node_count == 0 && leftmost() == header && rightmost() == header;
+    }
+    if (root()->get_color() != __rb_tree_black || root()->get_parent() != header)
+    {
+        return false;
+    }
+    if (leftmost() != minimum(root()) || rightmost() != maximum(root()))
+    {
+        return false;
+    }
+    if (__verify_subtree(root(), key_compare) < 0)
+    {
+        return false;
+    }
+    size_type n = 0;
+    for (const_iterator it = begin(); it != end(); ++it)
+    {
+        ++n;
+    }
+    return n == node_count;
+}
+
+//дxΪСdepthĽڵ
+template <class Key, class Value, class KeyOfValue, class Compare, class Alloc, class NodeUpdate, class Stats>
+typename rb_tree<Key, Value, KeyOfValue, Compare, Alloc, NodeUpdate, Stats>::link_type*
+rb_tree<Key, Value, KeyOfValue, Compare, Alloc, NodeUpdate, Stats>::__range_bounds(link_type x, size_type depth,
+    link_type* out)
+{
+    if (x == 0 || depth == 0)
+    {
+        return out;
+    }
+    out = __range_bounds(left(x), depth - 1, out);
+    *out++ = x;
+    return __range_bounds(right(x), depth - 1, out);
+}
+
+template <class Key, class Value, class KeyOfValue, class Compare, class Alloc, class NodeUpdate, class Stats>
+template <class Iterator, class OutputIterator>
+OutputIterator rb_tree<Key, Value, KeyOfValue, Compare, Alloc, NodeUpdate, Stats>::__split_range(size_type depth,
+    OutputIterator out) const
+{
+    //е㲻2^depth - 1Ҳڵ
+    size_type cap = size();
+    if (depth < sizeof(size_type) * 8 - 1 && (size_type(1) << depth) - 1 < cap)
+    {
+        cap = (size_type(1) << depth) - 1;
+    }
+    link_type* bounds = link_allocator::allocate(cap + 1);
+    link_type* last = __range_bounds(root(), depth, bounds);
+    Iterator first = Iterator(leftmost());
+    for (link_type* i = bounds; i != last; ++i)
+    {
+        *out++ = pair<Iterator, Iterator>(first, Iterator(*i));
+        first = Iterator(*i);
+    }
+    *out++ = pair<Iterator, Iterator>(first, Iterator(header));
+    link_allocator::deallocate(bounds, cap + 1);
+    return out;
+}
+
+//task(i, first, last)i[first, last)߳࣬߳̽ȡĶ
+template <class Key, class Value, class KeyOfValue, class Compare, class Alloc, class NodeUpdate, class Stats>
+template <class Task>
+void rb_tree<Key, Value, KeyOfValue, Compare, Alloc, NodeUpdate, Stats>::__run_ranges(Task& task) const
+{
+    size_type par_depth = parallel_depth(size());
+    if (par_depth == 0)
+    {
+        task(size_type(0), leftmost(), header);
+        return;
+    }
+
+    size_type depth = par_depth + size_type(range_split_levels);
+    size_type cap = (size_type(1) << depth) - 1;
+    link_type* bounds = link_allocator::allocate(cap);
+    size_type ranges = (__range_bounds(root(), depth, bounds) - bounds) + 1;
+    std::atomic<size_type> next(0);
+    auto work = [&]()
+    {
+        for (size_type i = next++; i < ranges; i = next++)
+        {
+            task(i, i == 0 ? leftmost() : bounds[i - 1], i == ranges - 1 ? header : bounds[i]);
+        }
+    };
+
+    //߳ԼҲȡһ
+    size_type helpers = (size_type(1) << par_depth) - 1;
+    std::thread* workers = simple_alloc<std::thread, Alloc>::allocate(helpers);
+    for (size_type i = 0; i < helpers; ++i)
+    {
+        construct(workers + i, work);
+    }
+    work();
+    for (size_type i = 0; i < helpers; ++i)
+    {
+        workers[i].join();
+    }
+    ::destroy(workers, workers + helpers);
+    simple_alloc<std::thread, Alloc>::deallocate(workers, helpers);
+    link_allocator::deallocate(bounds, cap);
+}
+
+template <class Key, class Value, class KeyOfValue, class Compare, class Alloc, class NodeUpdate, class Stats>
+template <class Function>
+void rb_tree<Key, Value, KeyOfValue, Compare, Alloc, NodeUpdate, Stats>::parallel_for_each(Function f)
+{
+    auto task = [&](size_type, link_type first, link_type last)
+    {
+        for (iterator i = iterator(first), e = iterator(last); i != e; ++i)
+        {
+            f(*i);
+        }
+    };
+    __run_ranges(task);
+}
+
+template <class Key, class Value, class KeyOfValue, class Compare, class Alloc, class NodeUpdate, class Stats>
+template <class Function>
+void rb_tree<Key, Value, KeyOfValue, Compare, Alloc, NodeUpdate, Stats>::parallel_for_each(Function f) const
+{
+    auto task = [&](size_type, link_type first, link_type last)
+    {
+        for (const_iterator i = const_iterator(first), e = const_iterator(last); i != e; ++i)
+        {
+            f(*i);
+        }
+    };
+    __run_ranges(task);
+}
+
+template <class Key, class Value, class KeyOfValue, class Compare, class Alloc, class NodeUpdate, class Stats>
+template <class T, class Accumulate, class Combine>
+T rb_tree<Key, Value, KeyOfValue, Compare, Alloc, NodeUpdate, Stats>::parallel_reduce(T identity, Accumulate acc,
+    Combine combine) const
+{
+    //iεĽpartial[i]ûõλñΪλԪ
+    size_type ranges = parallel_ranges();
+    T* partial = simple_alloc<T, Alloc>::allocate(ranges);
+    for (size_type i = 0; i < ranges; ++i)
+    {
+        construct(partial + i, identity);
+    }
+    auto task = [&](size_type index, link_type first, link_type last)
+    {
+        T result = identity;
+        for (const_iterator i = const_iterator(first), e = const_iterator(last); i != e; ++i)
+        {
+            result = acc(result, *i);
+        }
+        partial[index] = result;
+    };
+    __run_ranges(task);
+
+    T result = identity;
+    for (size_type i = 0; i < ranges; ++i)
+    {
+        result = combine(result, partial[i]);
+    }
+    ::destroy(partial, partial + ranges);
+    simple_alloc<T, Alloc>::deallocate(partial, ranges);
+    return result;
+}
 
 #endif //__MY_STL_TREE_H
\ No newline at end of file
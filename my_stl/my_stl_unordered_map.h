@@ -0,0 +1,191 @@
+#ifndef __MY_STL_UNORDERED_MAP_H
+#define __MY_STL_UNORDERED_MAP_H
+#include <functional>
+#include <initializer_list>
+#include <iostream>
+#include <tuple>
+#include <utility>
+#include "my_stl_hashtable.h"
+#include "my_stl_tree.h"
+using namespace std;
+
+//ӳ䣺ֻѯʱҪ򣬿ŶַĹϣƽһ̽ҵhashtable
+//ݣݺԭеĵȫʧЧ
+template <class Key, class T, class HashFcn = std::hash<Key>, class EqualKey = std::equal_to<Key>,
+    class Alloc = my_alloc>
+class my_unordered_map
+{
+public:
+    typedef Key key_type;
+    typedef T data_type;
+    typedef T mapped_type;
+    typedef pair<const Key, T> value_type;
+    typedef HashFcn hasher;
+    typedef EqualKey key_equal;
+
+private:
+    typedef hashtable<value_type, key_type, hasher, my_select1st<value_type>, key_equal, Alloc> rep_type;
+    rep_type t;
+
+public:
+    typedef typename rep_type::pointer pointer;
+    typedef typename rep_type::const_pointer const_pointer;
+    typedef typename rep_type::reference reference;
+    typedef typename rep_type::const_reference const_reference;
+    typedef typename rep_type::iterator iterator;
+    typedef typename rep_type::const_iterator const_iterator;
+    typedef typename rep_type::size_type size_type;
+    typedef typename rep_type::difference_type difference_type;
+
+    explicit my_unordered_map(size_type n = 0, const hasher& hf = hasher(), const key_equal& eql = key_equal())
+        : t(n, hf, eql) {}
+    template <class InputIterator>
+    my_unordered_map(InputIterator first, InputIterator last, size_type n = 0, const hasher& hf = hasher(),
+        const key_equal& eql = key_equal()) : t(n, hf, eql)
+    {
+        t.insert_unique(first, last);
+    }
+    my_unordered_map(initializer_list<value_type> l, size_type n = 0, const hasher& hf = hasher(),
+        const key_equal& eql = key_equal()) : t(n, hf, eql)
+    {
+        t.insert_unique(l.begin(), l.end());
+    }
+
+    hasher hash_function() const { return t.hash_funct(); }
+    key_equal key_eq() const { return t.key_eq(); }
+    iterator begin() { return t.begin(); }
+    const_iterator begin() const { return t.begin(); }
+    iterator end() { return t.end(); }
+    const_iterator end() const { return t.end(); }
+    bool empty() const { return t.empty(); }
+    size_type size() const { return t.size(); }
+    size_type max_size() const { return t.max_size(); }
+    void swap(my_unordered_map& x) { t.swap(x.t); }
+
+    size_type bucket_count() const { return t.bucket_count(); }
+    float load_factor() const { return t.load_factor(); }
+    float max_load_factor() const { return t.max_load_factor(); }
+    void max_load_factor(float f) { t.max_load_factor(f); }
+    void reserve(size_type n) { t.reserve(n); }
+    void rehash(size_type n) { t.rehash(n); }
+
+    //ʱڲֱӹT()ֻ̽һ
+    T& operator[](const key_type& k)
+    {
+        return (*t.emplace_unique_key(k, piecewise_construct, forward_as_tuple(k), tuple<>()).first).second;
+    }
+    T& operator[](key_type&& k)
+    {
+        return (*t.emplace_unique_key(k, piecewise_construct, forward_as_tuple(std::move(k)), tuple<>()).first).second;
+    }
+    //ʱֱ˳
+    T& at(const key_type& k)
+    {
+        iterator it = t.find(k);
+        if (it == end())
+        {
+            std::cerr << "my_unordered_map::at: key not found" << std::endl;
+            exit(1);
+        }
+        return (*it).second;
+    }
+    const T& at(const key_type& k) const
+    {
+        const_iterator it = t.find(k);
+        if (it == end())
+        {
+            std::cerr << "my_unordered_map::at: key not found" << std::endl;
+            exit(1);
+        }
+        return (*it).second;
+    }
+
+    //Ѵʱԭֵ
+    pair<iterator, bool> insert(const value_type& x)
+    {
+        return t.insert_unique(x);
+    }
+    pair<iterator, bool> insert(value_type&& x)
+    {
+        return t.emplace_unique_key(x.first, std::move(x));
+    }
+    template <class InputIterator>
+    void insert(InputIterator first, InputIterator last)
+    {
+        t.insert_unique(first, last);
+    }
+    void insert(initializer_list<value_type> l)
+    {
+        t.insert_unique(l.begin(), l.end());
+    }
+    template <class... Args>
+    pair<iterator, bool> emplace(Args&&... args)
+    {
+        return t.emplace_unique(std::forward<Args>(args)...);
+    }
+    //ʱargsڲйTѴʱargsᱻƶ
+    template <class... Args>
+    pair<iterator, bool> try_emplace(const key_type& k, Args&&... args)
+    {
+        return t.emplace_unique_key(k, piecewise_construct, forward_as_tuple(k),
+            forward_as_tuple(std::forward<Args>(args)...));
+    }
+    template <class... Args>
+    pair<iterator, bool> try_emplace(key_type&& k, Args&&... args)
+    {
+        return t.emplace_unique_key(k, piecewise_construct, forward_as_tuple(std::move(k)),
+            forward_as_tuple(std::forward<Args>(args)...));
+    }
+    //ʱ룬Ѵʱֵ
+    template <class M>
+    pair<iterator, bool> insert_or_assign(const key_type& k, M&& obj)
+    {
+        pair<iterator, bool> r = t.emplace_unique_key(k, piecewise_construct, forward_as_tuple(k),
+            forward_as_tuple(std::forward<M>(obj)));
+        if (!r.second)
+        {
+            (*r.first).second = std::forward<M>(obj);
+        }
+        return r;
+    }
+    template <class M>
+    pair<iterator, bool> insert_or_assign(key_type&& k, M&& obj)
+    {
+        pair<iterator, bool> r = t.emplace_unique_key(k, piecewise_construct, forward_as_tuple(std::move(k)),
+            forward_as_tuple(std::forward<M>(obj)));
+        if (!r.second)
+        {
+            (*r.first).second = std::forward<M>(obj);
+        }
+        return r;
+    }
+
+    //ɾƶֵȻЧ
+    void erase(const_iterator position) { t.erase(position); }
+    size_type erase(const key_type& k) { return t.erase(k); }
+    void clear() { t.clear(); }
+
+    iterator find(const key_type& k) { return t.find(k); }
+    const_iterator find(const key_type& k) const { return t.find(k); }
+    size_type count(const key_type& k) const { return t.count(k); }
+};
+
+template <class Key, class T, class HashFcn, class EqualKey, class Alloc>
+inline bool operator==(const my_unordered_map<Key, T, HashFcn, EqualKey, Alloc>& x,
+    const my_unordered_map<Key, T, HashFcn, EqualKey, Alloc>& y)
+{
+    if (x.size() != y.size())
+    {
+        return false;
+    }
+    for (typename my_unordered_map<Key, T, HashFcn, EqualKey, Alloc>::const_iterator it = x.begin(); it != x.end(); ++it)
+    {
+        typename my_unordered_map<Key, T, HashFcn, EqualKey, Alloc>::const_iterator j = y.find((*it).first);
+        if (j == y.end() || !((*j).second == (*it).second))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+#endif //__MY_STL_UNORDERED_MAP_H
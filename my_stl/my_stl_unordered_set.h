@@ -0,0 +1,114 @@
+#ifndef __MY_STL_UNORDERED_SET_H
+#define __MY_STL_UNORDERED_SET_H
+#include <functional>
+#include <initializer_list>
+#include <utility>
+#include "my_stl_hashtable.h"
+#include "my_stl_tree.h"
+using namespace std;
+
+//򼯺ϣֵͨ޸ģiteratorconst_iteratorhashtableconst_iterator
+template <class Value, class HashFcn = std::hash<Value>, class EqualKey = std::equal_to<Value>,
+    class Alloc = my_alloc>
+class my_unordered_set
+{
+public:
+    typedef Value key_type;
+    typedef Value value_type;
+    typedef HashFcn hasher;
+    typedef EqualKey key_equal;
+
+private:
+    typedef hashtable<value_type, key_type, hasher, my_identity<value_type>, key_equal, Alloc> rep_type;
+    rep_type t;
+
+public:
+    typedef typename rep_type::const_pointer pointer;
+    typedef typename rep_type::const_pointer const_pointer;
+    typedef typename rep_type::const_reference reference;
+    typedef typename rep_type::const_reference const_reference;
+    typedef typename rep_type::const_iterator iterator;
+    typedef typename rep_type::const_iterator const_iterator;
+    typedef typename rep_type::size_type size_type;
+    typedef typename rep_type::difference_type difference_type;
+
+    explicit my_unordered_set(size_type n = 0, const hasher& hf = hasher(), const key_equal& eql = key_equal())
+        : t(n, hf, eql) {}
+    template <class InputIterator>
+    my_unordered_set(InputIterator first, InputIterator last, size_type n = 0, const hasher& hf = hasher(),
+        const key_equal& eql = key_equal()) : t(n, hf, eql)
+    {
+        t.insert_unique(first, last);
+    }
+    my_unordered_set(initializer_list<value_type> l, size_type n = 0, const hasher& hf = hasher(),
+        const key_equal& eql = key_equal()) : t(n, hf, eql)
+    {
+        t.insert_unique(l.begin(), l.end());
+    }
+
+    hasher hash_function() const { return t.hash_funct(); }
+    key_equal key_eq() const { return t.key_eq(); }
+    iterator begin() const { return t.begin(); }
+    iterator end() const { return t.end(); }
+    bool empty() const { return t.empty(); }
+    size_type size() const { return t.size(); }
+    size_type max_size() const { return t.max_size(); }
+    void swap(my_unordered_set& x) { t.swap(x.t); }
+
+    size_type bucket_count() const { return t.bucket_count(); }
+    float load_factor() const { return t.load_factor(); }
+    float max_load_factor() const { return t.max_load_factor(); }
+    void max_load_factor(float f) { t.max_load_factor(f); }
+    void reserve(size_type n) { t.reserve(n); }
+    void rehash(size_type n) { t.rehash(n); }
+
+    pair<iterator, bool> insert(const value_type& x)
+    {
+        return t.insert_unique(x);
+    }
+    //Ȱx̽飬ֵʱŰxƽ
+    pair<iterator, bool> insert(value_type&& x)
+    {
+        return t.emplace_unique_key(x, std::move(x));
+    }
+    template <class InputIterator>
+    void insert(InputIterator first, InputIterator last)
+    {
+        t.insert_unique(first, last);
+    }
+    void insert(initializer_list<value_type> l)
+    {
+        t.insert_unique(l.begin(), l.end());
+    }
+    template <class... Args>
+    pair<iterator, bool> emplace(Args&&... args)
+    {
+        return t.emplace_unique(std::forward<Args>(args)...);
+    }
+
+    void erase(iterator position) { t.erase(position); }
+    size_type erase(const key_type& k) { return t.erase(k); }
+    void clear() { t.clear(); }
+
+    iterator find(const key_type& k) const { return t.find(k); }
+    size_type count(const key_type& k) const { return t.count(k); }
+};
+
+template <class Value, class HashFcn, class EqualKey, class Alloc>
+inline bool operator==(const my_unordered_set<Value, HashFcn, EqualKey, Alloc>& x,
+    const my_unordered_set<Value, HashFcn, EqualKey, Alloc>& y)
+{
+    if (x.size() != y.size())
+    {
+        return false;
+    }
+    for (typename my_unordered_set<Value, HashFcn, EqualKey, Alloc>::const_iterator it = x.begin(); it != x.end(); ++it)
+    {
+        if (y.find(*it) == y.end())
+        {
+            return false;
+        }
+    }
+    return true;
+}
+#endif //__MY_STL_UNORDERED_SET_H
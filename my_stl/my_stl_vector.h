@@ -11,7 +11,9 @@ public:
     typedef T value_type;
     typedef value_type* pointer;
     typedef value_type* iterator;
+    typedef const value_type* const_iterator;
     typedef value_type& reference;
+    typedef const value_type& const_reference;
     typedef size_t size_type;
     typedef ptrdiff_t difference_type;
 
@@ -45,6 +47,14 @@ public:
     {
         return finish;
     }
+    const_iterator begin() const
+    {
+        return start;
+    }
+    const_iterator end() const
+    {
+        return finish;
+    }
     size_type size() const
     {
         return size_type(finish - start);
@@ -60,6 +70,10 @@ public:
     {
         return *(start + n);
     }
+    const_reference operator[](size_type n) const
+    {
+        return *(start + n);
+    }
 
     //캯
     my_vector() : start(0), finish(0), end_of_storage(0) {};
@@ -83,7 +97,7 @@ public:
     //
     ~my_vector()
     {
-        destroy(start, finish);
+        ::destroy(start, finish);
         deallocate();
     }
 
@@ -111,7 +125,7 @@ public:
     void pop_back()
     {
         --finish;
-        destroy(finish);
+        ::destroy(finish);
     }
 
     iterator erase(iterator position)
@@ -121,14 +135,14 @@ public:
             copy(position + 1, finish, position);   //Ԫǰ
         }
         --finish;
-        destroy(finish);
+        ::destroy(finish);
         return position;
     }
 
     iterator erase(iterator first, iterator last)
     {
         iterator i = copy(last, finish, first);
-        destroy(i, finish);
+        ::destroy(i, finish);
         finish = finish - (last - first);
         return first;
     }
@@ -153,6 +167,52 @@ public:
     {
         erase(begin(), end());
     }
+    iterator insert(iterator position, const T& x)
+    {
+        size_type n = position - begin();
+        if (finish != end_of_storage && position == end())
+        {
+            construct(finish, x);
+            ++finish;
+        }
+        else
+        {
+            insert_aux(position, x);
+        }
+        return begin() + n;
+    }
+
+    //ԤnԪصĿռ䣬֮벻nԪʱ
+    void reserve(size_type n)
+    {
+        if (capacity() < n)
+        {
+            const size_type old_size = size();
+            iterator new_start = data_allocator::allocate(n);
+            try
+            {
+                uninitialized_copy(start, finish, new_start);
+            }
+            catch (...)
+            {
+                data_allocator::deallocate(new_start, n);
+                throw;
+            }
+            ::destroy(start, finish);
+            deallocate();
+            start = new_start;
+            finish = new_start + old_size;
+            end_of_storage = new_start + n;
+        }
+    }
+
+    void swap(my_vector& x)
+    {
+        std::swap(start, x.start);
+        std::swap(finish, x.finish);
+        std::swap(end_of_storage, x.end_of_storage);
+    }
+
     void insert(iterator position, size_type n, const T &x)
     {
         if (n != 0)
@@ -191,18 +251,18 @@ public:
                 try
                 {
                     new_finish = uninitialized_copy(start, position, new_start);
-                    new_finish = uninitialized_fill_n(new_start, n, x);
-                    new_finish = uninitialized_copy(position, finish, new_start);
+                    new_finish = uninitialized_fill_n(new_finish, n, x);
+                    new_finish = uninitialized_copy(position, finish, new_finish);
                 }
                 catch (...)
                 {
-                    destroy(new_start, new_finish);
+                    ::destroy(new_start, new_finish);
                     data_allocator::deallocate(new_start, len);
                     throw;
                 }
 
                 //ڴ
-                destroy(start, finish);
+                ::destroy(start, finish);
                 deallocate();
 
                 start = new_start;
@@ -254,13 +314,13 @@ void my_vector<T, Alloc>::insert_aux(iterator position, const T& x)
         catch (...)
         {
         	//commit or rollback
-            destroy(new_start, new_finish);
+            ::destroy(new_start, new_finish);
             data_allocator::deallocate(new_start, len);
             throw;
         }
 
         //ͷԭvector
-        destroy(begin(), end());
+        ::destroy(begin(), end());
         deallocate();
         
         //ָvector